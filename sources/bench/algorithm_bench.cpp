@@ -0,0 +1,223 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <core/algorithm/ac.hpp>
+#include <core/algorithm/band_sum.hpp>
+#include <core/algorithm/sor.hpp>
+#include <core/algorithm/vwap.hpp>
+#include <exchange/binance/info.hpp>
+#include <exchange/binance/serializer.hpp>
+#include <vector>
+
+#include "fixtures.hpp"
+
+namespace bench {
+namespace {
+namespace ca = core::algorithm;
+
+/**
+ * @brief Band sets of increasing size, the first is the default of the application.
+ */
+std::vector<float> Bands(int64_t count) {
+    static const std::vector<float> all{0.01, 0.02, 0.05, 0.001, 0.002, 0.005, 0.1, 0.2};
+    return {all.begin(), all.begin() + count};
+}
+
+/**
+ * @brief VWAP::Compute on the books of the depth fixture with `levels` levels per side.
+ */
+void BM_VwapCompute(benchmark::State& state) {
+    const auto books = LoadBooks(fmt::format("ethusdt_depth{}.jsonl", state.range(0)));
+    ca::VWAP vwap{exchange::binance::ethusdt, Bands(state.range(1))};
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            vwap.Compute(books[i++ % books.size()], exchange::binance::params.takerFee));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VwapCompute)->ArgNames({"levels", "bands"})->ArgsProduct({{5, 10, 20}, {1, 3, 8}});
+
+/**
+ * @brief VWAP::Compute on the columns of the snapshots, without a book.
+ *
+ * Fails if a result differs from VWAP::Compute on the book of the same snapshot.
+ */
+void BM_VwapColumns(benchmark::State& state) {
+    const auto name = fmt::format("ethusdt_depth{}.jsonl", state.range(0));
+    const auto snapshots = LoadSnapshots(name);
+    const auto books = LoadBooks(name);
+    const auto fee = exchange::binance::params.takerFee;
+    ca::VWAP vwap{exchange::binance::ethusdt, Bands(state.range(1))};
+    ca::VWAP reference{exchange::binance::ethusdt, Bands(state.range(1))};
+
+    for (std::size_t i = 0; i < snapshots.size(); ++i) {
+        const auto& expected = reference.Compute(books[i], fee);
+        const auto& results = vwap.Compute(snapshots[i], fee);
+        if (!std::ranges::equal(results, expected, [](const auto& lhs, const auto& rhs) {
+                return lhs.vwapBid == rhs.vwapBid && lhs.vwapAsk == rhs.vwapAsk;
+            })) {
+            state.SkipWithError("columns and book results differ");
+            return;
+        }
+    }
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(vwap.Compute(snapshots[i++ % snapshots.size()], fee));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VwapColumns)->ArgNames({"levels", "bands"})->ArgsProduct({{5, 10, 20}, {1, 3, 8}});
+
+/**
+ * @brief One band sum per side of the depth20 snapshots with the kernel `isa`.
+ *
+ * `isa:0..2` = scalar, SSE4.2, AVX2; kernels the CPU lacks are skipped. Fails if a
+ * total differs from the scalar kernel on any snapshot.
+ */
+void BM_SumBand(benchmark::State& state) {
+    using Side = ca::OrderBook::Side;
+    const auto isa = static_cast<ca::Isa>(state.range(0));
+    if (!ca::Supported(isa)) {
+        state.SkipWithError("kernel is not supported by the CPU");
+        return;
+    }
+
+    const auto snapshots = LoadSnapshots("ethusdt_depth20.jsonl");
+    const auto books = LoadBooks("ethusdt_depth20.jsonl");
+    // every band from the top of book to past the deepest level
+    for (std::size_t i = 0; i < snapshots.size(); ++i) {
+        for (auto side : {Side::Bid, Side::Ask}) {
+            for (const auto& level : books[i].Depth(side)) {
+                for (auto limit : {level.price - 1, level.price, level.price + 1}) {
+                    const auto sum = ca::SumBand(snapshots[i], side, limit, isa);
+                    const auto expected = ca::SumBand(snapshots[i], side, limit, ca::Isa::Scalar);
+                    if (sum.notional != expected.notional || sum.volume != expected.volume) {
+                        state.SkipWithError("kernel and scalar totals differ");
+                        return;
+                    }
+                }
+            }
+        }
+    }
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const auto& book = books[i % books.size()];
+        const auto& snapshot = snapshots[i++ % snapshots.size()];
+        // the deepest level, so the whole side is in the band
+        benchmark::DoNotOptimize(
+            ca::SumBand(snapshot, Side::Bid, book.Depth(Side::Bid).front().price, isa));
+        benchmark::DoNotOptimize(
+            ca::SumBand(snapshot, Side::Ask, book.Depth(Side::Ask).front().price, isa));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SumBand)->ArgName("isa")->DenseRange(0, 2);
+
+/**
+ * @brief Trades of the fixture with the books they are tracked against.
+ */
+struct Market {
+    std::vector<common::event::NormalizedEvent> trades; /**< Parsed trades. */
+    std::vector<ca::OrderBook> books;                   /**< Depth20 snapshots. */
+
+    static const Market& Instance() {
+        static const Market market = [] {
+            exchange::binance::TradeSerializer serializer{exchange::binance::ethusdt};
+            return Market{Parse(serializer, LoadFixture("ethusdt_trade.jsonl")),
+                          LoadBooks("ethusdt_depth20.jsonl")};
+        }();
+        return market;
+    }
+};
+
+/**
+ * @brief Feeds the i-th trade of the market, moving the mid price every few trades.
+ *
+ * Timestamps keep increasing across passes over the fixture, as windows expect.
+ */
+void Feed(ca::AlmgrenChrissTracker& tracker, const Market& market, std::size_t i) {
+    const auto& trades = market.trades;
+    if (i % 4 == 0) {
+        tracker.UpdateBook(market.books[(i / 4) % market.books.size()]);
+    }
+    auto trade = trades[i % trades.size()];
+    const auto pass = i / trades.size();
+    trade.exchangeTsUs += pass * (trades.back().exchangeTsUs - trades.front().exchangeTsUs + 1);
+    tracker.AddEvent(trade);
+}
+
+ca::ACConfig Config(int64_t mode) {
+    ca::ACConfig config;
+    config.mode = static_cast<ca::ACMode>(mode);
+    config.windowSize = 1024;
+    return config;
+}
+
+/**
+ * @brief AlmgrenChrissTracker::AddEvent (and UpdateBook every 4 trades) per regression mode.
+ */
+void BM_AcAddEvent(benchmark::State& state) {
+    const auto& market = Market::Instance();
+    ca::AlmgrenChrissTracker tracker{exchange::binance::ethusdt, Config(state.range(0))};
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        Feed(tracker, market, i++);
+        // the batch mode keeps every point, end a period as often as the application would
+        if (i % market.trades.size() == 0) {
+            tracker.ClearEvents();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AcAddEvent)
+    ->ArgName("mode")
+    ->DenseRange(static_cast<int>(ca::ACMode::Batch), static_cast<int>(ca::ACMode::Exponential));
+
+/**
+ * @brief AlmgrenChrissTracker::ComputeRegression after `trades` trades per regression mode.
+ */
+void BM_AcComputeRegression(benchmark::State& state) {
+    const auto& market = Market::Instance();
+    ca::AlmgrenChrissTracker tracker{exchange::binance::ethusdt, Config(state.range(0))};
+    const auto trades = static_cast<std::size_t>(state.range(1));
+    for (std::size_t i = 0; i < trades; ++i) {
+        Feed(tracker, market, i);
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tracker.ComputeRegression());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AcComputeRegression)
+    ->ArgNames({"mode", "trades"})
+    ->ArgsProduct({benchmark::CreateDenseRange(static_cast<int>(ca::ACMode::Batch),
+                                               static_cast<int>(ca::ACMode::Exponential), 1),
+                   {256, 4096, 65536}});
+
+/**
+ * @brief SOR::Compute over `venues` venues.
+ */
+void BM_SorCompute(benchmark::State& state) {
+    const ca::SOR sor{exchange::binance::params.lambda, exchange::binance::params.targetAmount};
+    std::vector<ca::VenueData> venues;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        const auto offset = static_cast<float>(i) * 0.05f;
+        venues.push_back({exchange::binance::venue, 2451.31f + offset, 2451.42f + offset,
+                          1e-4f * static_cast<float>(i + 1), 2e-5f * static_cast<float>(i + 1)});
+    }
+
+    for (auto _ : state) {
+        sor.Compute(venues);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SorCompute)->ArgName("venues")->RangeMultiplier(2)->Range(1, 16);
+}  // namespace
+}  // namespace bench
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+
+namespace bench {
+
+/**
+ * @brief Returns the number of heap allocations made by the process so far.
+ *
+ * Linking bench/allocations.cpp replaces the global operator new to count them.
+ */
+uint64_t Allocations() noexcept;
+
+}  // namespace bench
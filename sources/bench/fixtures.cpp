@@ -0,0 +1,104 @@
+#include "fixtures.hpp"
+
+#include <fmt/format.h>
+
+#include <core/interface/notifier.hpp>
+#include <cstring>
+#include <exchange/binance/info.hpp>
+#include <exchange/binance/serializer.hpp>
+#include <filesystem>
+#include <fstream>
+#include <network/capture/reader.hpp>
+#include <stdexcept>
+
+namespace bench {
+
+std::vector<std::string> LoadFixture(std::string_view name) {
+    const auto path = std::filesystem::path{MARKET_DEMO_BENCH_DATA} / name;
+    std::ifstream file{path};
+    if (!file) {
+        throw std::runtime_error{fmt::format("Failed to open fixture {}", path.string())};
+    }
+
+    std::vector<std::string> messages;
+    for (std::string line; std::getline(file, line);) {
+        if (!line.empty()) {
+            messages.push_back(std::move(line));
+        }
+    }
+    if (messages.empty()) {
+        throw std::runtime_error{fmt::format("Fixture {} is empty", path.string())};
+    }
+    return messages;
+}
+
+std::vector<std::string> LoadCapture(const std::filesystem::path& path) {
+    network::capture::Reader reader{path};
+
+    std::vector<std::string> messages;
+    for (network::capture::Frame frame; reader.Next(frame);) {
+        messages.emplace_back(reinterpret_cast<const char*>(frame.data.data()), frame.data.size());
+    }
+    if (messages.empty()) {
+        throw std::runtime_error{fmt::format("Capture {} is empty", path.string())};
+    }
+    return messages;
+}
+
+Frame::Frame(const std::vector<std::string>& messages, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        m_size += messages[i % messages.size()].size() + 1;
+    }
+    m_data.resize(m_size + core::interface::receivePadding);
+
+    auto* out = m_data.data();
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& message = messages[i % messages.size()];
+        std::memcpy(out, message.data(), message.size());
+        out += message.size();
+        *out++ = std::byte{'\n'};
+    }
+}
+
+std::vector<common::event::NormalizedEvent> Parse(core::interface::ISerializer& serializer,
+                                                  const std::vector<std::string>& messages) {
+    std::vector<common::event::NormalizedEvent> events;
+    for (const auto& message : messages) {
+        Frame frame{{message}, 1};
+        core::error_handling::ErrorCode ec;
+        if (!serializer.Serialize(frame.Data(), 0, events, ec)) {
+            throw std::runtime_error{fmt::format("Failed to parse a fixture: {}", ec)};
+        }
+    }
+    return events;
+}
+
+std::vector<core::algorithm::OrderBook> LoadBooks(std::string_view name) {
+    exchange::binance::DepthSerializer serializer{exchange::binance::ethusdt};
+
+    std::vector<core::algorithm::OrderBook> books;
+    for (const auto& event : Parse(serializer, LoadFixture(name))) {
+        // every snapshot starts with the best bid
+        if (books.empty() ||
+            (event.type == common::event::Type::Bid && event.level == 0)) {
+            books.emplace_back();
+        }
+        books.back().Apply(event);
+    }
+    return books;
+}
+
+std::vector<common::event::EventColumns> LoadSnapshots(std::string_view name) {
+    exchange::binance::DepthSerializer serializer{exchange::binance::ethusdt};
+
+    std::vector<common::event::EventColumns> snapshots;
+    for (const auto& message : LoadFixture(name)) {
+        Frame frame{{message}, 1};
+        core::error_handling::ErrorCode ec;
+        if (!serializer.Serialize(frame.Data(), 0, snapshots.emplace_back(), ec)) {
+            throw std::runtime_error{fmt::format("Failed to parse a fixture: {}", ec)};
+        }
+    }
+    return snapshots;
+}
+}  // namespace bench
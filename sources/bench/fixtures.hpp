@@ -0,0 +1,80 @@
+#pragma once
+
+#include <common/event/event_columns.hpp>
+#include <common/event/normalized_event.hpp>
+#include <core/algorithm/order_book.hpp>
+#include <core/interface/serializer.hpp>
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bench {
+
+/**
+ * @brief Loads a checked-in fixture of Binance stream messages.
+ *
+ * Fixtures live in bench/data and hold one JSON message per line, exactly as received
+ * from the stream.
+ *
+ * @param name File name of the fixture, e.g. "ethusdt_depth20.jsonl".
+ * @return The messages in file order.
+ * @throws std::runtime_error If the fixture cannot be read or is empty.
+ */
+std::vector<std::string> LoadFixture(std::string_view name);
+
+/**
+ * @brief Loads the frames of a capture file recorded with `--record`.
+ *
+ * @param path Path of the capture file.
+ * @return The frame payloads in capture order.
+ * @throws std::runtime_error If the capture cannot be read or is empty.
+ */
+std::vector<std::string> LoadCapture(const std::filesystem::path& path);
+
+/**
+ * @brief A received frame: concatenated messages followed by the receive padding.
+ */
+class Frame final {
+public:
+    /**
+     * @brief Concatenates messages into a frame.
+     *
+     * @param messages Messages to take from, reused from the start if too few.
+     * @param count Number of messages in the frame.
+     */
+    Frame(const std::vector<std::string>& messages, std::size_t count);
+
+    /**
+     * @brief Returns the frame without the padding, as passed to ISerializer::Serialize.
+     */
+    inline std::span<std::byte> Data() noexcept { return {m_data.data(), m_size}; }
+
+private:
+    std::vector<std::byte> m_data; /**< Frame followed by receivePadding bytes. */
+    std::size_t m_size = 0;        /**< Frame size without the padding. */
+};
+
+/**
+ * @brief Parses messages one by one and collects the resulting events.
+ *
+ * @throws std::runtime_error If a message fails to parse.
+ */
+std::vector<common::event::NormalizedEvent> Parse(core::interface::ISerializer& serializer,
+                                                  const std::vector<std::string>& messages);
+
+/**
+ * @brief Builds one order book per depth snapshot of a fixture.
+ */
+std::vector<core::algorithm::OrderBook> LoadBooks(std::string_view name);
+
+/**
+ * @brief Parses every depth snapshot of a fixture into its own columns.
+ *
+ * @throws std::runtime_error If a message fails to parse.
+ */
+std::vector<common::event::EventColumns> LoadSnapshots(std::string_view name);
+
+}  // namespace bench
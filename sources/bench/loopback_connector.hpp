@@ -0,0 +1,78 @@
+#pragma once
+
+#include <core/interface/connector.hpp>
+#include <core/interface/notifier.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bench {
+
+/**
+ * @brief Connector that delivers frames from memory instead of the network.
+ *
+ * Every subscription is "connected" right away. Frames are handed to the notifier of a
+ * target by Push() on the calling thread, which takes the role of the network thread.
+ */
+class LoopbackConnector final : public core::interface::IConnector {
+public:
+    /**
+     * @brief Registers the notifier of a target and reports it connected.
+     */
+    void Subscribe(std::string_view target, core::interface::INotifier* notifier) override {
+        m_targets.push_back({std::string{target}, notifier});
+        notifier->OnConnectionSuccessed();
+    }
+
+    /**
+     * @brief Returns the index of a subscribed target.
+     *
+     * @throws std::out_of_range If the target was not subscribed.
+     */
+    std::size_t Find(std::string_view target) const {
+        for (std::size_t i = 0; i < m_targets.size(); ++i) {
+            if (m_targets[i].name == target) {
+                return i;
+            }
+        }
+        throw std::out_of_range{"Target is not subscribed: " + std::string{target}};
+    }
+
+    /**
+     * @brief Returns the number of subscribed targets.
+     */
+    inline std::size_t Size() const noexcept { return m_targets.size(); }
+
+    /**
+     * @brief Delivers a frame to a target.
+     *
+     * @param idx Index of the target.
+     * @param frame Frame followed by core::interface::receivePadding readable bytes.
+     * @param recvTsNs Receive time reported with the frame.
+     */
+    inline void Push(std::size_t idx, std::span<std::byte> frame, uint64_t recvTsNs) {
+        m_targets[idx].notifier->OnReceiveSuccessed(frame, recvTsNs);
+    }
+
+    /**
+     * @brief Reports a new connection of a target, as after a reconnect.
+     */
+    inline void Reconnect(std::size_t idx) { m_targets[idx].notifier->OnConnectionSuccessed(); }
+
+private:
+    /**
+     * @brief A subscribed target.
+     */
+    struct Target {
+        std::string name;                     /**< Subscription target. */
+        core::interface::INotifier* notifier; /**< Notifier of the target. */
+    };
+
+    std::vector<Target> m_targets; /**< Subscribed targets in subscription order. */
+};
+
+}  // namespace bench
@@ -0,0 +1,167 @@
+#include <benchmark/benchmark.h>
+#include <simdjson.h>
+
+#include <algorithm>
+#include <common/event/packed_event.hpp>
+#include <cstdint>
+#include <exchange/binance/info.hpp>
+#include <exchange/binance/serializer.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "allocations.hpp"
+#include "fixtures.hpp"
+
+namespace bench {
+namespace {
+using Events = core::interface::ISerializer::Events;
+
+/**
+ * @brief Frames of `count` consecutive messages, each starting at another message.
+ *
+ * Prices, quantities and IDs vary in width, so the frames vary in length as received
+ * frames do. Unless `wrap` is set, a frame never runs past the last message, which keeps
+ * the update IDs of depth snapshots consecutive.
+ */
+std::vector<Frame> MakeFrames(const std::vector<std::string>& messages, std::size_t count,
+                              bool wrap) {
+    constexpr std::size_t maxFrames = 16;
+    const auto starts = wrap ? messages.size() : messages.size() - count + 1;
+
+    std::vector<Frame> frames;
+    for (std::size_t first = 0; first < std::min(starts, maxFrames); ++first) {
+        std::vector<std::string> rotated{messages.begin() + first, messages.end()};
+        rotated.insert(rotated.end(), messages.begin(), messages.begin() + first);
+        frames.emplace_back(rotated, count);
+    }
+    return frames;
+}
+
+/**
+ * @brief Runs a serializer over frames of different lengths in turn, the way the parse
+ * stage does.
+ *
+ * Events go to one caller-owned buffer that is cleared, not freed, between frames.
+ * After a warm-up over every frame has grown the buffer and the parser, the loop must
+ * not allocate: a heap allocation fails the benchmark.
+ */
+template <typename Serializer>
+void RunSerializer(benchmark::State& state, Serializer& serializer, std::vector<Frame>& frames) {
+    Events events;
+    core::error_handling::ErrorCode ec;
+    for (auto& frame : frames) {
+        serializer.Reset();
+        if (!serializer.Serialize(frame.Data(), 0, events, ec)) {
+            state.SkipWithError("failed to parse the fixture");
+            return;
+        }
+    }
+
+    int64_t bytes = 0;
+    std::size_t next = 0;
+    const auto allocations = Allocations();
+    for (auto _ : state) {
+        auto& frame = frames[next];
+        next = next + 1 == frames.size() ? 0 : next + 1;
+        // frames start over with their own update IDs
+        serializer.Reset();
+        events.clear();
+        if (!serializer.Serialize(frame.Data(), 0, events, ec)) {
+            state.SkipWithError("failed to parse the fixture");
+            break;
+        }
+        bytes += static_cast<int64_t>(frame.Data().size());
+        benchmark::DoNotOptimize(events.data());
+    }
+    if (Allocations() != allocations) {
+        state.SkipWithError("the serializer allocated on the hot path");
+    }
+    state.SetBytesProcessed(bytes);
+}
+
+/**
+ * @brief Splitting a frame of concatenated trades into JSON documents, without parsing them.
+ *
+ * Frames of combined or batched streams carry several objects; this is the cost the
+ * serializers pay before reading any field.
+ */
+void BM_SplitFrame(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    Frame frame{LoadFixture("ethusdt_trade.jsonl"), count};
+    simdjson::ondemand::parser parser;
+
+    for (auto _ : state) {
+        const auto data = frame.Data();
+        simdjson::ondemand::document_stream docs;
+        if (parser
+                .iterate_many(reinterpret_cast<const char*>(data.data()), data.size(),
+                              data.size())
+                .get(docs)) {
+            state.SkipWithError("invalid frame");
+            break;
+        }
+        std::size_t objects = 0;
+        for (auto it = docs.begin(); it != docs.end(); ++it) {
+            benchmark::DoNotOptimize(it.current_index());
+            ++objects;
+        }
+        benchmark::DoNotOptimize(objects);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(frame.Data().size()));
+}
+BENCHMARK(BM_SplitFrame)->ArgName("objects")->Arg(1)->Arg(4)->Arg(16)->Arg(64);
+
+/**
+ * @brief DepthSerializer on frames of `snapshots` partial book snapshots of `levels` levels.
+ */
+void BM_DepthSerializer(benchmark::State& state) {
+    const auto levels = state.range(0);
+    const auto snapshots = static_cast<std::size_t>(state.range(1));
+    auto frames = MakeFrames(LoadFixture(fmt::format("ethusdt_depth{}.jsonl", levels)),
+                             snapshots, false);
+    exchange::binance::DepthSerializer serializer{exchange::binance::ethusdt};
+
+    RunSerializer(state, serializer, frames);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(snapshots));
+}
+// snapshots per frame leave several frames within the 16 consecutive update IDs of a fixture
+BENCHMARK(BM_DepthSerializer)
+    ->ArgNames({"levels", "snapshots"})
+    ->ArgsProduct({{5, 10, 20}, {1, 4, 8}});
+
+/**
+ * @brief TradeSerializer on frames of `trades` trades.
+ */
+void BM_TradeSerializer(benchmark::State& state) {
+    const auto trades = static_cast<std::size_t>(state.range(0));
+    auto frames = MakeFrames(LoadFixture("ethusdt_trade.jsonl"), trades, true);
+    exchange::binance::TradeSerializer serializer{exchange::binance::ethusdt};
+
+    RunSerializer(state, serializer, frames);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(trades));
+}
+BENCHMARK(BM_TradeSerializer)->ArgName("trades")->Arg(1)->Arg(16)->Arg(64)->Arg(256);
+
+/**
+ * @brief Packing the events of the depth20 fixture into PackedEvent for storage.
+ */
+void BM_PackEvents(benchmark::State& state) {
+    exchange::binance::DepthSerializer serializer{exchange::binance::ethusdt};
+    const auto events = Parse(serializer, LoadFixture("ethusdt_depth20.jsonl"));
+    std::vector<common::event::PackedEvent> packed(events.size());
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < events.size(); ++i) {
+            packed[i] = common::event::PackedEvent{events[i]};
+        }
+        benchmark::DoNotOptimize(packed.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(events.size()));
+    state.SetBytesProcessed(state.iterations() *
+                            static_cast<int64_t>(packed.size() * sizeof(packed.front())));
+}
+BENCHMARK(BM_PackEvents);
+}  // namespace
+}  // namespace bench
@@ -0,0 +1,274 @@
+#include <fmt/format.h>
+#include <time.h>
+
+#include <chrono>
+#include <core/log/log.hpp>
+#include <engine/event_bus.hpp>
+#include <engine/pipeline.hpp>
+#include <exchange/binance/generator.hpp>
+#include <exchange/binance/handler.hpp>
+#include <exchange/binance/info.hpp>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "allocations.hpp"
+#include "fixtures.hpp"
+#include "loopback_connector.hpp"
+
+namespace {
+using exchange::binance::EventType;
+
+struct Args {
+    std::size_t handlers = 1;                 /**< Handlers, each with depth and trades. */
+    std::chrono::milliseconds warmup{1000};   /**< Feeding time before the measurement. */
+    std::chrono::milliseconds duration{5000}; /**< Measured feeding time. */
+    std::filesystem::path depthCapture;       /**< Depth frames, fixtures if empty. */
+    std::filesystem::path tradeCapture;       /**< Trade frames, fixtures if empty. */
+    std::size_t symbols = 0;                  /**< Generated symbols, none if 0. */
+    engine::Pipeline::Options pipeline;       /**< Stage threads and their CPUs. */
+};
+
+Args ParseArgs(int argc, char* argv[]) {
+    Args args;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--handlers" && i + 1 < argc) {
+            args.handlers = std::stoul(argv[++i]);
+        } else if (arg == "--warmup-ms" && i + 1 < argc) {
+            args.warmup = std::chrono::milliseconds{std::stol(argv[++i])};
+        } else if (arg == "--duration-ms" && i + 1 < argc) {
+            args.duration = std::chrono::milliseconds{std::stol(argv[++i])};
+        } else if (arg == "--depth" && i + 1 < argc) {
+            args.depthCapture = argv[++i];
+        } else if (arg == "--trade" && i + 1 < argc) {
+            args.tradeCapture = argv[++i];
+        } else if (arg == "--synthetic" && i + 1 < argc) {
+            args.symbols = std::stoul(argv[++i]);
+        } else if (arg == "--parse-cpu" && i + 1 < argc) {
+            args.pipeline.parseCpu = std::stoi(argv[++i]);
+        } else if (arg == "--strategy-cpu" && i + 1 < argc) {
+            args.pipeline.strategyCpu = std::stoi(argv[++i]);
+        } else {
+            throw std::invalid_argument{
+                "Usage: market_demo-throughput [--handlers N] [--warmup-ms MS] "
+                "[--duration-ms MS] [--depth DEPTH.cap] [--trade TRADE.cap] "
+                "[--synthetic SYMBOLS] [--parse-cpu C] [--strategy-cpu C]"};
+        }
+    }
+    if (args.handlers == 0) {
+        throw std::invalid_argument{"At least one handler is needed"};
+    }
+    return args;
+}
+
+/**
+ * @brief Frames of one stream, delivered in a loop.
+ */
+struct Stream {
+    std::string target;               /**< Subscription target. */
+    EventType type;                   /**< Kind of the frames. */
+    std::vector<bench::Frame> frames; /**< Frames in delivery order. */
+};
+
+Stream LoadStream(std::string target, EventType type, const std::filesystem::path& capture,
+                  std::string_view fixture) {
+    const auto messages =
+        capture.empty() ? bench::LoadFixture(fixture) : bench::LoadCapture(capture);
+
+    Stream stream{std::move(target), type, {}};
+    stream.frames.reserve(messages.size());
+    for (const auto& message : messages) {
+        stream.frames.emplace_back(std::vector{message}, 1);
+    }
+    return stream;
+}
+
+Stream GenerateStream(std::string target, EventType type,
+                      const exchange::binance::GeneratorConfig& config) {
+    // enough frames to keep the loop out of the caches, like a long capture
+    constexpr std::size_t frames = 4096;
+
+    exchange::binance::Generator generator{config, target};
+    Stream stream{std::move(target), type, {}};
+    stream.frames.reserve(frames);
+    std::string message;
+    for (std::size_t i = 0; i < frames; ++i) {
+        generator.Next(message);
+        stream.frames.emplace_back(std::vector{message}, 1);
+    }
+    return stream;
+}
+
+/**
+ * @brief A handler with the loopback connector its streams are pushed through.
+ */
+struct Lane {
+    exchange::binance::Handler* handler;                 /**< Handler, owned by the pipeline. */
+    std::shared_ptr<bench::LoopbackConnector> connector; /**< Transport of the handler. */
+    std::vector<Stream>* streams;                        /**< Streams of the handler. */
+    std::vector<std::size_t> next;                       /**< Next frame of every stream. */
+    uint64_t pushed = 0;                                 /**< Frames pushed so far. */
+};
+
+uint64_t CpuNs(clockid_t clock) {
+    timespec ts{};
+    clock_gettime(clock, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000 + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+/**
+ * @brief Totals at a point of the run.
+ */
+struct Sample {
+    std::chrono::steady_clock::time_point time; /**< Monotonic time. */
+    uint64_t processCpuNs;                      /**< CPU time of all threads. */
+    uint64_t feedCpuNs;                         /**< CPU time of the feeding thread. */
+    uint64_t allocations;                       /**< Heap allocations. */
+    exchange::binance::Handler::Stats stats;    /**< Stage counters summed over handlers. */
+};
+
+Sample Take(const std::vector<Lane>& lanes) {
+    Sample sample{std::chrono::steady_clock::now(), CpuNs(CLOCK_PROCESS_CPUTIME_ID),
+                  CpuNs(CLOCK_THREAD_CPUTIME_ID), bench::Allocations(),
+                  {}};
+    for (const auto& lane : lanes) {
+        const auto stats = lane.handler->GetStats();
+        sample.stats.framesParsed += stats.framesParsed;
+        sample.stats.eventsParsed += stats.eventsParsed;
+        sample.stats.framesDropped += stats.framesDropped;
+        sample.stats.errors += stats.errors;
+    }
+    return sample;
+}
+
+void Report(const Args& args, const Sample& begin, const Sample& end) {
+    const auto seconds = std::chrono::duration<double>(end.time - begin.time).count();
+    const auto frames = static_cast<double>(end.stats.framesParsed - begin.stats.framesParsed);
+    const auto events = static_cast<double>(end.stats.eventsParsed - begin.stats.eventsParsed);
+    if (frames == 0) {
+        LOG(warn, "No frame was parsed in {:.2f} s", seconds);
+        return;
+    }
+
+    const auto feedCpu = static_cast<double>(end.feedCpuNs - begin.feedCpuNs);
+    const auto stageCpu = static_cast<double>(end.processCpuNs - begin.processCpuNs) - feedCpu;
+    LOG(info, "Handlers: {}, measured {:.2f} s", args.handlers, seconds);
+    LOG(info, "Throughput: {:.0f} frames/s, {:.0f} events/s ({:.1f} events/frame)",
+        frames / seconds, events / seconds, events / frames);
+    LOG(info, "CPU: {:.0f} ns/frame in the parse and strategy stages, {:.0f} ns/frame feeding",
+        stageCpu / frames, feedCpu / frames);
+    LOG(info, "Allocations: {:.2f}/frame",
+        static_cast<double>(end.allocations - begin.allocations) / frames);
+    LOG(info, "Dropped frames: {}, errors: {}", end.stats.framesDropped - begin.stats.framesDropped,
+        end.stats.errors - begin.stats.errors);
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        core::log::init_logger();
+
+        const auto args = ParseArgs(argc, argv);
+
+        // every handler serves the depth and the trade stream of a symbol, round-robin
+        std::vector<std::string> symbols;
+        std::vector<std::vector<Stream>> feeds;
+        if (args.symbols == 0) {
+            symbols.emplace_back(exchange::binance::ethusdt.name);
+            feeds.push_back({LoadStream("/ws/ethusdt@depth20@100ms", EventType::Depth,
+                                        args.depthCapture, "ethusdt_depth20.jsonl"),
+                             LoadStream("/ws/ethusdt@trade", EventType::Trade,
+                                        args.tradeCapture, "ethusdt_trade.jsonl")});
+        } else {
+            exchange::binance::GeneratorConfig generator;
+            generator.priceDecimals = exchange::binance::ethusdt.priceDecimals;
+            generator.sizeDecimals = exchange::binance::ethusdt.sizeDecimals;
+            for (std::size_t i = 0; i < args.symbols; ++i) {
+                const auto& symbol = symbols.emplace_back(fmt::format("syn{}usdt", i));
+                generator.seed = i + 1;
+                feeds.push_back(
+                    {GenerateStream(fmt::format("/ws/{}@depth20@100ms", symbol), EventType::Depth,
+                                    generator),
+                     GenerateStream(fmt::format("/ws/{}@trade", symbol), EventType::Trade,
+                                    generator)});
+            }
+        }
+
+        exchange::binance::Config config;
+        config.symbol = exchange::binance::ethusdt;
+        engine::StrategyConfig strategy;
+        strategy.symbol = exchange::binance::ethusdt;
+        strategy.venue = exchange::binance::venue;
+        strategy.params = exchange::binance::params;
+
+        engine::Pipeline pipeline{args.pipeline};
+        // frames are pushed with no receive time, so the bus never waits for reordering
+        auto bus = std::make_unique<engine::EventBus>();
+        std::vector<Lane> lanes;
+        for (std::size_t i = 0; i < args.handlers; ++i) {
+            auto& streams = feeds[i % feeds.size()];
+            config.symbol.name = symbols[i % symbols.size()];
+            strategy.symbol.name = config.symbol.name;
+
+            auto connector = std::make_shared<bench::LoopbackConnector>();
+            auto handler = std::make_unique<exchange::binance::Handler>(connector, config);
+            for (const auto& stream : streams) {
+                handler->AddTarget(stream.type, stream.target);
+            }
+            bus->AddSource(bus->AddSymbol(strategy), *handler);
+            lanes.push_back({handler.get(), std::move(connector), &streams,
+                             std::vector<std::size_t>(streams.size(), 0)});
+            pipeline.AddHandler(std::move(handler));
+        }
+        pipeline.AddHandler(std::move(bus));
+        pipeline.Init();
+        pipeline.Start();
+
+        // keep at most half a ring in flight, so frames wait here instead of being dropped
+        const auto inFlight = config.frameQueueSize / 2;
+        const auto feed = [&](std::chrono::milliseconds period) {
+            const auto until = std::chrono::steady_clock::now() + period;
+            // the clock is read once every 64 rounds
+            for (uint64_t round = 0;
+                 (round & 63) != 0 || std::chrono::steady_clock::now() < until; ++round) {
+                for (auto& lane : lanes) {
+                    while (lane.pushed - lane.handler->GetStats().framesParsed >= inFlight) {
+                        std::this_thread::yield();
+                    }
+                    for (std::size_t s = 0; s < lane.streams->size(); ++s) {
+                        auto& stream = (*lane.streams)[s];
+                        auto& position = lane.next[s];
+                        if (position == stream.frames.size()) {
+                            position = 0;
+                            // the snapshots start over with old update IDs, as after a reconnect
+                            if (stream.type == EventType::Depth) {
+                                lane.connector->Reconnect(s);
+                            }
+                        }
+                        lane.connector->Push(s, stream.frames[position++].Data(), 0);
+                        ++lane.pushed;
+                    }
+                }
+            }
+        };
+
+        feed(args.warmup);
+        const auto begin = Take(lanes);
+        feed(args.duration);
+        const auto end = Take(lanes);
+        pipeline.Stop();
+
+        Report(args, begin, end);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
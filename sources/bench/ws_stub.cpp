@@ -0,0 +1,398 @@
+#include <fmt/format.h>
+#include <simdjson.h>
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/signal_set.hpp>
+#include <boost/asio/ssl/context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <boost/beast/ssl.hpp>
+#include <boost/beast/websocket.hpp>
+#include <boost/beast/websocket/ssl.hpp>
+#include <chrono>
+#include <core/log/log.hpp>
+#include <csignal>
+#include <cstdint>
+#include <deque>
+#include <exchange/binance/generator.hpp>
+#include <exchange/binance/info.hpp>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+namespace beast = boost::beast;
+namespace http = boost::beast::http;
+namespace net = boost::asio;
+namespace ssl = boost::asio::ssl;
+using tcp = boost::asio::ip::tcp;
+
+constexpr std::string_view wsPrefix = "/ws/";
+constexpr std::string_view combinedPrefix = "/stream?streams=";
+
+struct Args {
+    uint16_t port = exchange::binance::port; /**< Listening port. */
+    std::filesystem::path cert;              /**< PEM certificate chain. */
+    std::filesystem::path key;               /**< PEM private key. */
+    std::size_t threads = 1;                 /**< Threads running the io_context. */
+    exchange::binance::GeneratorConfig generator;
+};
+
+Args ParseArgs(int argc, char* argv[]) {
+    Args args;
+    args.generator.priceDecimals = exchange::binance::ethusdt.priceDecimals;
+    args.generator.sizeDecimals = exchange::binance::ethusdt.sizeDecimals;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--port" && i + 1 < argc) {
+            args.port = static_cast<uint16_t>(std::stoul(argv[++i]));
+        } else if (arg == "--cert" && i + 1 < argc) {
+            args.cert = argv[++i];
+        } else if (arg == "--key" && i + 1 < argc) {
+            args.key = argv[++i];
+        } else if (arg == "--threads" && i + 1 < argc) {
+            args.threads = std::stoul(argv[++i]);
+        } else if (arg == "--rate" && i + 1 < argc) {
+            args.generator.rate = std::stod(argv[++i]);
+        } else if (arg == "--burst-probability" && i + 1 < argc) {
+            args.generator.burstProbability = std::stod(argv[++i]);
+        } else if (arg == "--burst-factor" && i + 1 < argc) {
+            args.generator.burstFactor = std::stod(argv[++i]);
+        } else if (arg == "--burst-messages" && i + 1 < argc) {
+            args.generator.burstMessages = std::stoul(argv[++i]);
+        } else if (arg == "--volatility" && i + 1 < argc) {
+            args.generator.volatility = std::stod(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            args.generator.seed = std::stoull(argv[++i]);
+        } else {
+            throw std::invalid_argument{
+                "Usage: market_demo-ws-stub --cert CERT.pem --key KEY.pem [--port PORT] "
+                "[--threads N] [--rate MSG_PER_S] [--burst-probability P] [--burst-factor F] "
+                "[--burst-messages N] [--volatility V] [--seed S]"};
+        }
+    }
+    if (args.cert.empty() || args.key.empty()) {
+        throw std::invalid_argument{"A certificate and its key are needed"};
+    }
+    if (args.threads == 0) {
+        throw std::invalid_argument{"At least one thread is needed"};
+    }
+    return args;
+}
+
+/**
+ * @brief A client connection served with generated streams.
+ *
+ * Messages are written at the generated times; a client that reads slower than
+ * that gets them back to back. SUBSCRIBE and UNSUBSCRIBE requests change the
+ * generated streams and are answered like Binance does, ahead of queued data.
+ */
+class Connection final : public std::enable_shared_from_this<Connection> {
+public:
+    Connection(tcp::socket socket, ssl::context& ctx,
+               const exchange::binance::GeneratorConfig& config)
+        : m_ws(std::move(socket), ctx), m_timer(m_ws.get_executor()), m_config(config) {}
+
+    void Run() {
+        beast::get_lowest_layer(m_ws).expires_after(std::chrono::seconds{10});
+        m_ws.next_layer().async_handshake(
+            ssl::stream_base::server,
+            beast::bind_front_handler(&Connection::OnSslHandshake, shared_from_this()));
+    }
+
+private:
+    void OnSslHandshake(beast::error_code ec) {
+        if (ec) {
+            LOG(warn, "SSL handshake failed: {}", ec.message());
+            return;
+        }
+        http::async_read(m_ws.next_layer(), m_buffer, m_request,
+                         beast::bind_front_handler(&Connection::OnRequest, shared_from_this()));
+    }
+
+    void OnRequest(beast::error_code ec, std::size_t) {
+        if (ec || !beast::websocket::is_upgrade(m_request)) {
+            LOG(warn, "Expected a websocket upgrade: {}", ec ? ec.message() : "plain request");
+            return;
+        }
+
+        std::string_view target{m_request.target().data(), m_request.target().size()};
+        m_combined = target.starts_with(combinedPrefix);
+        if (!m_combined && !target.starts_with(wsPrefix)) {
+            LOG(warn, "Unexpected target {}", target);
+            return;
+        }
+        target.remove_prefix(m_combined ? combinedPrefix.size() : wsPrefix.size());
+        while (!target.empty()) {
+            const auto slash = target.find('/');
+            m_streams.emplace_back(target.substr(0, slash));
+            target.remove_prefix(slash == std::string_view::npos ? target.size() : slash + 1);
+        }
+
+        try {
+            m_generator.emplace(m_config, Target());
+        } catch (const std::exception& e) {
+            LOG(warn, "Cannot serve {}: {}", Target(), e.what());
+            return;
+        }
+
+        beast::get_lowest_layer(m_ws).expires_never();
+        m_ws.set_option(
+            beast::websocket::stream_base::timeout::suggested(beast::role_type::server));
+        m_ws.async_accept(m_request,
+                          beast::bind_front_handler(&Connection::OnAccept, shared_from_this()));
+    }
+
+    void OnAccept(beast::error_code ec) {
+        if (ec) {
+            LOG(warn, "Websocket handshake failed: {}", ec.message());
+            return;
+        }
+
+        LOG(info, "Serving {}", Target());
+        m_ws.text(true);
+        m_due = std::chrono::steady_clock::now();
+        m_ws.async_read(m_input,
+                        beast::bind_front_handler(&Connection::OnRead, shared_from_this()));
+        Schedule();
+    }
+
+    /**
+     * @brief Generates the next message and writes it when due, replies go first.
+     */
+    void Schedule() {
+        if (m_closed) {
+            return;
+        }
+        if (!m_replies.empty()) {
+            m_writing = std::move(m_replies.front());
+            m_replies.pop_front();
+            Write();
+            return;
+        }
+
+        if (m_pending.empty()) {
+            // due times are absolute, so timer latency does not lower the rate
+            m_due += m_generator->Next(m_pending);
+        }
+        m_waiting = true;
+        m_timer.expires_at(m_due);
+        m_timer.async_wait([self = shared_from_this()](beast::error_code ec) {
+            self->m_waiting = false;
+            if (ec == net::error::operation_aborted && !self->m_closed) {
+                // woken up by a reply
+                self->Schedule();
+                return;
+            }
+            if (ec || self->m_closed) {
+                return;
+            }
+            if (self->m_pending.empty()) {
+                self->Schedule();
+                return;
+            }
+            self->m_writing = std::move(self->m_pending);
+            self->m_pending.clear();
+            self->Write();
+        });
+    }
+
+    void Write() {
+        m_ws.async_write(net::buffer(m_writing),
+                         [self = shared_from_this()](beast::error_code ec, std::size_t) {
+                             if (ec) {
+                                 LOG(info, "Client of {} is gone: {}", self->Target(),
+                                     ec.message());
+                                 self->Close();
+                                 return;
+                             }
+                             self->Schedule();
+                         });
+    }
+
+    void OnRead(beast::error_code ec, std::size_t) {
+        if (ec) {
+            LOG(info, "Client of {} is gone: {}", Target(), ec.message());
+            Close();
+            return;
+        }
+
+        const auto data = m_input.cdata();
+        Handle(std::string_view{static_cast<const char*>(data.data()), data.size()});
+        m_input.consume(m_input.size());
+        m_ws.async_read(m_input,
+                        beast::bind_front_handler(&Connection::OnRead, shared_from_this()));
+    }
+
+    /**
+     * @brief Applies a SUBSCRIBE/UNSUBSCRIBE request and queues its response.
+     */
+    void Handle(std::string_view request) {
+        simdjson::padded_string json{request};
+        simdjson::ondemand::document doc;
+        std::string_view method;
+        uint64_t id = 0;
+        std::vector<std::string> params;
+
+        auto err = m_parser.iterate(json).get(doc);
+        if (!err) {
+            err = doc["method"].get_string().get(method);
+        }
+        simdjson::ondemand::array array;
+        if (!err) {
+            err = doc["params"].get_array().get(array);
+        }
+        if (!err) {
+            for (auto param : array) {
+                std::string_view stream;
+                if (err = param.get_string().get(stream); err) {
+                    break;
+                }
+                params.emplace_back(stream);
+            }
+        }
+        if (!err) {
+            err = doc["id"].get_uint64().get(id);
+        }
+
+        bool accepted = !err && (method == "SUBSCRIBE" || method == "UNSUBSCRIBE");
+        if (accepted) {
+            auto streams = m_streams;
+            for (auto& stream : params) {
+                std::erase(streams, stream);
+                if (method == "SUBSCRIBE") {
+                    streams.push_back(std::move(stream));
+                }
+            }
+            std::swap(streams, m_streams);
+            try {
+                m_generator->SetTarget(Target());
+            } catch (const std::exception& e) {
+                LOG(warn, "Rejected {}: {}", request, e.what());
+                std::swap(streams, m_streams);
+                accepted = false;
+            }
+        }
+
+        m_replies.push_back(
+            accepted ? fmt::format(R"({{"result":null,"id":{}}})", id)
+                     : fmt::format(R"({{"error":{{"code":2,"msg":"Invalid request"}},"id":{}}})",
+                                   id));
+        if (m_waiting) {
+            m_timer.cancel();
+        }
+    }
+
+    std::string Target() const {
+        std::string target{m_combined ? combinedPrefix : wsPrefix};
+        for (const auto& stream : m_streams) {
+            if (&stream != &m_streams.front()) {
+                target += '/';
+            }
+            target += stream;
+        }
+        return target;
+    }
+
+    void Close() {
+        m_closed = true;
+        m_timer.cancel();
+    }
+
+private:
+    beast::websocket::stream<beast::ssl_stream<beast::tcp_stream>> m_ws; /**< Client stream. */
+    net::steady_timer m_timer;                               /**< Pacing timer. */
+    exchange::binance::GeneratorConfig m_config;             /**< Generator settings. */
+    beast::flat_buffer m_buffer;                             /**< Buffer of the upgrade. */
+    http::request<http::string_body> m_request;              /**< Upgrade request. */
+    beast::flat_buffer m_input;                              /**< Buffer of client requests. */
+    simdjson::ondemand::parser m_parser;                     /**< Parser of client requests. */
+    std::optional<exchange::binance::Generator> m_generator; /**< Generator of the streams. */
+    std::vector<std::string> m_streams;                      /**< Served stream names. */
+    bool m_combined = false;                                 /**< Combined-stream connection. */
+    std::deque<std::string> m_replies;                       /**< Responses to be written. */
+    std::string m_pending;                                   /**< Generated message, not due. */
+    std::string m_writing;                                   /**< Message being written. */
+    std::chrono::steady_clock::time_point m_due;             /**< Write time of m_pending. */
+    bool m_waiting = false;                                  /**< The pacing timer is armed. */
+    bool m_closed = false;                                   /**< The client is gone. */
+};
+
+/**
+ * @brief Accepts clients and hands them to connections of their own.
+ */
+class Listener final : public std::enable_shared_from_this<Listener> {
+public:
+    Listener(net::io_context& ioc, ssl::context& ctx, const Args& args)
+        : m_ioc(ioc), m_ctx(ctx), m_acceptor(net::make_strand(ioc)), m_config(args.generator) {
+        const tcp::endpoint endpoint{net::ip::make_address("127.0.0.1"), args.port};
+        m_acceptor.open(endpoint.protocol());
+        m_acceptor.set_option(net::socket_base::reuse_address(true));
+        m_acceptor.bind(endpoint);
+        m_acceptor.listen();
+    }
+
+    void Accept() {
+        m_acceptor.async_accept(
+            net::make_strand(m_ioc),
+            [self = shared_from_this()](beast::error_code ec, tcp::socket socket) {
+                if (ec) {
+                    LOG(err, "Failed to accept: {}", ec.message());
+                } else {
+                    socket.set_option(tcp::no_delay(true));
+                    std::make_shared<Connection>(std::move(socket), self->m_ctx, self->m_config)
+                        ->Run();
+                }
+                self->Accept();
+            });
+    }
+
+private:
+    net::io_context& m_ioc;                      /**< Context of the connections. */
+    ssl::context& m_ctx;                         /**< Server TLS context. */
+    tcp::acceptor m_acceptor;                    /**< Listening socket. */
+    exchange::binance::GeneratorConfig m_config; /**< Generator settings. */
+};
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        core::log::init_logger();
+
+        const auto args = ParseArgs(argc, argv);
+
+        ssl::context ctx{ssl::context::tls_server};
+        ctx.use_certificate_chain_file(args.cert.string());
+        ctx.use_private_key_file(args.key.string(), ssl::context::pem);
+
+        net::io_context ioc{static_cast<int>(args.threads)};
+        std::make_shared<Listener>(ioc, ctx, args)->Accept();
+        LOG(info, "Listening on 127.0.0.1:{}", args.port);
+
+        net::signal_set signals{ioc, SIGINT, SIGTERM};
+        signals.async_wait([&ioc](beast::error_code, int) { ioc.stop(); });
+
+        std::vector<std::thread> threads;
+        for (std::size_t i = 1; i < args.threads; ++i) {
+            threads.emplace_back([&ioc] { ioc.run(); });
+        }
+        ioc.run();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace common::decimal {
+
+/**
+ * @brief Fixed-point decimal helpers.
+ *
+ * Prices and sizes are kept as int64 multiples of 10^-decimals, where the number
+ * of decimals is configured per symbol (tick size for prices, lot size for sizes).
+ * Aggregations over such values are exact integer arithmetic; conversion to
+ * floating point happens only at the edges (results, logs).
+ */
+
+static constexpr uint8_t maxDecimals = 18; /**< Largest supported scale. */
+
+/**
+ * @brief Returns 10^n for n in [0, maxDecimals].
+ */
+constexpr int64_t Pow10(uint8_t n) noexcept {
+    constexpr auto table = [] {
+        std::array<int64_t, maxDecimals + 1> pows{};
+        pows[0] = 1;
+        for (std::size_t i = 1; i < pows.size(); ++i) {
+            pows[i] = pows[i - 1] * 10;
+        }
+        return pows;
+    }();
+    return table[n];
+}
+
+/**
+ * @brief Converts a fixed-point value to double.
+ *
+ * @param value Value in units of 10^-decimals.
+ * @param decimals Scale of the value.
+ */
+constexpr double ToDouble(int64_t value, uint8_t decimals) noexcept {
+    return static_cast<double>(value) / static_cast<double>(Pow10(decimals));
+}
+
+namespace detail {
+inline bool IsDigit(char c) noexcept {
+    return static_cast<unsigned char>(c - '0') < 10;
+}
+
+/**
+ * @brief Parses exactly 8 ASCII digits at once (SWAR, little-endian).
+ *
+ * @return False if any of the 8 characters is not a digit.
+ */
+inline bool ParseEightDigits(const char* p, uint64_t& out) noexcept {
+    uint64_t chunk;
+    std::memcpy(&chunk, p, sizeof(chunk));
+
+    // every byte must be in ['0', '9']: high nibble is 3 and adding 6 does not carry out of it
+    const uint64_t carry = ((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4;
+    if (((chunk & 0xF0F0F0F0F0F0F0F0) | carry) != 0x3333333333333333) {
+        return false;
+    }
+
+    chunk -= 0x3030303030303030;
+    chunk = (chunk * 10) + (chunk >> 8);
+    chunk = (((chunk & 0x000000FF000000FF) * (100 + (1000000ULL << 32))) +
+             (((chunk >> 16) & 0x000000FF000000FF) * (1 + (10000ULL << 32)))) >>
+            32;
+    out = chunk;
+    return true;
+}
+}  // namespace detail
+
+/**
+ * @brief Parses a decimal string ("-123.4500") into a fixed-point integer.
+ *
+ * Fractional digits beyond `decimals` must be zeros, so the conversion is exact;
+ * anything else (a finer value than the scale allows, exponents, garbage or overflow)
+ * is rejected. Exchange feeds usually pad numbers to 8 decimals, which are consumed
+ * with a single SWAR step.
+ *
+ * @param str Decimal string.
+ * @param decimals Target scale, at most `maxDecimals`.
+ * @param out Parsed value in units of 10^-decimals.
+ * @return True on success; otherwise false.
+ */
+inline bool Parse(std::string_view str, uint8_t decimals, int64_t& out) noexcept {
+    const char* p = str.data();
+    const char* const end = p + str.size();
+
+    const bool negative = p != end && *p == '-';
+    p += negative;
+
+    uint64_t value = 0;
+    int digits = 0;
+    for (; p != end && detail::IsDigit(*p); ++p, ++digits) {
+        value = value * 10 + static_cast<uint64_t>(*p - '0');
+    }
+    if (digits == 0) [[unlikely]] {
+        return false;
+    }
+
+    uint8_t frac = 0;
+    if (p != end && *p == '.') {
+        ++p;
+        uint64_t eight;
+        if constexpr (std::endian::native == std::endian::little) {
+            if (decimals <= 8 && end - p >= 8 && detail::ParseEightDigits(p, eight)) {
+                const auto drop = Pow10(static_cast<uint8_t>(8 - decimals));
+                if (eight % drop != 0) [[unlikely]] {
+                    return false;
+                }
+                value = value * static_cast<uint64_t>(Pow10(decimals)) +
+                        eight / static_cast<uint64_t>(drop);
+                frac = decimals;
+                digits += decimals;
+                p += 8;
+            }
+        }
+        for (; p != end && frac < decimals && detail::IsDigit(*p); ++p, ++frac, ++digits) {
+            value = value * 10 + static_cast<uint64_t>(*p - '0');
+        }
+        while (p != end && *p == '0') {
+            ++p;
+        }
+    }
+
+    if (p != end || digits + (decimals - frac) > maxDecimals) [[unlikely]] {
+        return false;
+    }
+
+    value *= static_cast<uint64_t>(Pow10(static_cast<uint8_t>(decimals - frac)));
+    out = negative ? -static_cast<int64_t>(value) : static_cast<int64_t>(value);
+    return true;
+}
+
+}  // namespace common::decimal
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "normalized_event.hpp"
+
+namespace common::event {
+
+/**
+ * @brief Structure-of-arrays batch of market events.
+ *
+ * Keeps the fields that aggregations read (price, size, level and side) in
+ * separate contiguous arrays, so reductions over a batch load only the columns
+ * they need and can be vectorized. Element i of every column belongs to the
+ * same event. The side is a bitmask: bit i of the mask is set if event i is a
+ * bid. Other events are asks, or trades, which have no side.
+ *
+ * Columns keep their capacity when cleared, so a batch reused across frames
+ * does not allocate once it has grown.
+ */
+struct EventColumns {
+    std::vector<int64_t> price;  /**< Prices in ticks. */
+    std::vector<int64_t> size;   /**< Sizes in lots. */
+    std::vector<uint16_t> level; /**< Order book levels (0 = top of book). */
+    std::vector<uint64_t> bids;  /**< Side bitmask, 64 events per word. */
+
+    /**
+     * @brief Returns the number of events.
+     */
+    inline std::size_t Size() const noexcept { return price.size(); }
+
+    /**
+     * @brief Checks whether event `i` is a bid.
+     */
+    inline bool IsBid(std::size_t i) const noexcept { return (bids[i / 64] >> (i % 64)) & 1; }
+
+    /**
+     * @brief Appends an event.
+     *
+     * @param event The event to append.
+     */
+    inline void Append(const NormalizedEvent& event) {
+        const auto i = Size();
+        if (i % 64 == 0) {
+            bids.push_back(0);
+        }
+        bids.back() |= static_cast<uint64_t>(event.type == Type::Bid) << (i % 64);
+        price.push_back(event.price);
+        size.push_back(event.size);
+        level.push_back(event.level);
+    }
+
+    /**
+     * @brief Drops the events past the first `count` ones.
+     *
+     * @param count Number of events to keep, at most Size().
+     */
+    inline void Truncate(std::size_t count) {
+        price.resize(count);
+        size.resize(count);
+        level.resize(count);
+        bids.resize((count + 63) / 64);
+        if (count % 64 != 0) {
+            bids.back() &= (uint64_t{1} << (count % 64)) - 1;
+        }
+    }
+
+    /**
+     * @brief Removes all events.
+     */
+    inline void Clear() noexcept {
+        price.clear();
+        size.clear();
+        level.clear();
+        bids.clear();
+    }
+};
+
+}  // namespace common::event
@@ -5,8 +5,10 @@
 namespace common::event {
 std::string format_as(const NormalizedEvent& event) {
     return fmt::format(
-        "\n\tvenue={}\n\tts={}\n\tprice={}\n\tsize={}\n\tlevel={}\n\ttype={}\n\tsource={}",
-        event.venue, event.tsUs, event.price, event.size, event.level,
-        magic_enum::enum_name(event.type), magic_enum::enum_name(event.source));
+        "\n\tvenue={}\n\tsymbol={}\n\texchangeTs={}\n\trecvTs={}\n\tts={}\n\tprice={}\n\tsize={}"
+        "\n\tlevel={}\n\ttype={}\n\tsource={}",
+        common::exchange::VenueName(event.venue), common::exchange::SymbolName(event.symbol),
+        event.exchangeTsUs, event.recvTsUs, event.tsUs, event.price, event.size,
+        event.level, magic_enum::enum_name(event.type), magic_enum::enum_name(event.source));
 }
 }  // namespace common::event
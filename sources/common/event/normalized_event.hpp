@@ -2,15 +2,16 @@
 
 #include <fmt/format.h>
 
+#include <common/exchange/registry.hpp>
 #include <cstdint>
-#include <string_view>
+#include <type_traits>
 
 namespace common::event {
 
 /**
  * @brief Represents the event type (order side).
  */
-enum class Type {
+enum class Type : uint8_t {
     Unspecified, /**< Undefined or unknown event type. */
     Ask,         /**< Ask order (sell). */
     Bid          /**< Bid order (buy). */
@@ -19,7 +20,7 @@ enum class Type {
 /**
  * @brief Represents the origin of the event.
  */
-enum class Source {
+enum class Source : uint8_t {
     Depth, /**< Event originates from the order book (market depth). */
     Trade  /**< Event originates from trade data. */
 };
@@ -29,17 +30,30 @@ enum class Source {
  *
  * This structure provides a unified format for storing market events
  * received from different exchanges or data feeds.
+ *
+ * All timestamps are wall-clock time since the epoch. Together they split the latency
+ * of an event into exchange → socket (exchangeTsUs → recvTsUs, includes clock offset)
+ * and socket → parsed (recvTsUs → tsUs); the decision time is taken by the consumer.
+ *
+ * Venue and symbol are dense ids of the registry (see common/exchange/registry.hpp),
+ * so events of many symbols can share a queue and be routed by id. The event holds
+ * no pointers; PackedEvent is its 24-byte form for storage.
  */
 struct NormalizedEvent {
-    std::string_view venue; /**< Exchange or data source identifier. */
-    uint64_t tsUs;          /**< Event timestamp in microseconds. */
-    float price;            /**< Price at which the event occurred. */
-    float size;             /**< Size or volume associated with the event. */
-    uint16_t level;         /**< Order book level (0 = top of book). */
-    Type type;              /**< Event type (Bid or Ask). */
-    Source source;          /**< Source of the event (Depth or Trade). */
+    uint64_t exchangeTsUs;             /**< Exchange time in microseconds, 0 if not published. */
+    uint64_t recvTsUs;                 /**< Socket receive time in microseconds. */
+    uint64_t tsUs;                     /**< Parse time in microseconds. */
+    int64_t price;                     /**< Price in ticks (see SymbolParams::priceDecimals). */
+    int64_t size;                      /**< Size in lots (see SymbolParams::sizeDecimals). */
+    uint16_t level;                    /**< Order book level (0 = top of book). */
+    common::exchange::SymbolId symbol; /**< Symbol of the event. */
+    common::exchange::VenueId venue;   /**< Exchange or data source of the event. */
+    Type type;                         /**< Event type (Bid or Ask). */
+    Source source;                     /**< Source of the event (Depth or Trade). */
 };
 
+static_assert(sizeof(NormalizedEvent) == 48);
+
 /**
  * @brief Converts a normalized event to a formatted string.
  *
@@ -48,4 +62,11 @@ struct NormalizedEvent {
  */
 std::string format_as(const NormalizedEvent& event);
 
+/**
+ * @brief Lets the asynchronous logger copy events instead of formatting them on the hot path.
+ *
+ * Safe because the event holds no pointers.
+ */
+std::true_type log_by_value(const NormalizedEvent& event);
+
 }  // namespace common::event
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <common/exchange/registry.hpp>
+#include <cstdint>
+#include <stdexcept>
+
+#include "normalized_event.hpp"
+
+namespace common::event {
+
+/**
+ * @brief A normalized event packed into 24 bytes for storage.
+ *
+ * Three words hold the price and the symbol id, the size and the level, and the
+ * exchange time with the venue id, side and source:
+ *
+ *     price:48 symbol:16 | size:48 level:16 | exchangeTsUs:52 venue:8 type:2 source:2
+ *
+ * 48-bit prices and sizes cover ±1.4e14 ticks and lots, 52-bit microseconds last
+ * until the year 2112. The receive and parse times are shared by all events of a
+ * frame, so they are left out and passed back to Unpack().
+ *
+ * The handler does not queue packed events: core::interface::EventBatch carries
+ * NormalizedEvent, which the strategy reads without unpacking.
+ */
+class PackedEvent final {
+public:
+    static constexpr int valueBits = 48; /**< Bits of a packed price or size. */
+    static constexpr int timeBits = 52;  /**< Bits of the packed exchange time. */
+
+    PackedEvent() = default;
+
+    /**
+     * @brief Packs an event.
+     *
+     * @param event The event to pack.
+     * @throws std::out_of_range if the price, size or exchange time does not fit (see Fits()).
+     */
+    explicit PackedEvent(const NormalizedEvent& event)
+        : m_price(Word(event.price, event.symbol)),
+          m_size(Word(event.size, event.level)),
+          m_meta((event.exchangeTsUs & Mask(timeBits)) | uint64_t{event.venue} << timeBits |
+                 uint64_t{static_cast<uint8_t>(event.type)} << (timeBits + 8) |
+                 uint64_t{static_cast<uint8_t>(event.source)} << (timeBits + 10)) {
+        if (!Fits(event)) [[unlikely]] {
+            throw std::out_of_range{"Event does not fit the packed layout"};
+        }
+    }
+
+    /**
+     * @brief Checks whether an event round-trips through the packed layout.
+     */
+    static constexpr bool Fits(const NormalizedEvent& event) noexcept {
+        constexpr int64_t limit = int64_t{1} << (valueBits - 1);
+        return event.price >= -limit && event.price < limit && event.size >= -limit &&
+               event.size < limit && event.exchangeTsUs <= Mask(timeBits);
+    }
+
+    inline int64_t Price() const noexcept { return Value(m_price); }
+
+    inline int64_t Size() const noexcept { return Value(m_size); }
+
+    inline common::exchange::SymbolId Symbol() const noexcept {
+        return static_cast<common::exchange::SymbolId>(m_price >> valueBits);
+    }
+
+    inline uint16_t Level() const noexcept { return static_cast<uint16_t>(m_size >> valueBits); }
+
+    inline uint64_t ExchangeTsUs() const noexcept { return m_meta & Mask(timeBits); }
+
+    inline common::exchange::VenueId Venue() const noexcept {
+        return static_cast<common::exchange::VenueId>(m_meta >> timeBits);
+    }
+
+    inline event::Type Type() const noexcept {
+        return static_cast<event::Type>((m_meta >> (timeBits + 8)) & 0x3);
+    }
+
+    inline event::Source Source() const noexcept {
+        return static_cast<event::Source>((m_meta >> (timeBits + 10)) & 0x3);
+    }
+
+    /**
+     * @brief Restores the event with the times of its frame.
+     *
+     * @param recvTsUs Socket receive time of the frame in microseconds.
+     * @param tsUs Parse time of the frame in microseconds.
+     */
+    inline NormalizedEvent Unpack(uint64_t recvTsUs, uint64_t tsUs) const noexcept {
+        return NormalizedEvent{ExchangeTsUs(), recvTsUs, tsUs,  Price(),  Size(),
+                               Level(),        Symbol(),  Venue(), Type(), Source()};
+    }
+
+private:
+    static constexpr uint64_t Mask(int bits) noexcept { return (uint64_t{1} << bits) - 1; }
+
+    static constexpr uint64_t Word(int64_t value, uint16_t high) noexcept {
+        return (static_cast<uint64_t>(value) & Mask(valueBits)) | uint64_t{high} << valueBits;
+    }
+
+    // shifting the sign bit up and back extends it
+    static constexpr int64_t Value(uint64_t word) noexcept {
+        return static_cast<int64_t>(word << (64 - valueBits)) >> (64 - valueBits);
+    }
+
+private:
+    uint64_t m_price = 0; /**< Price and symbol id. */
+    uint64_t m_size = 0;  /**< Size and level. */
+    uint64_t m_meta = 0;  /**< Exchange time, venue id, type and source. */
+};
+
+static_assert(sizeof(PackedEvent) == 24);
+
+}  // namespace common::event
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdint>
+#include <string_view>
+
 namespace common::exchange {
 
 /**
@@ -15,4 +18,16 @@ struct ExchangeParams {
     float targetAmount; /**< The target trade amount or position size. */
 };
 
+/**
+ * @brief Parameters of a traded symbol.
+ *
+ * Prices and sizes of the symbol are represented as fixed-point integers
+ * (see common/decimal/decimal.hpp) scaled by the tick and lot decimals.
+ */
+struct SymbolParams {
+    std::string_view name; /**< Exchange symbol name, e.g. "ethusdt". */
+    uint8_t priceDecimals; /**< Prices are stored in units of 10^-priceDecimals (tick size). */
+    uint8_t sizeDecimals;  /**< Sizes are stored in units of 10^-sizeDecimals (lot size). */
+};
+
 }  // namespace common::exchange
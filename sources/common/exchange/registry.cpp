@@ -0,0 +1,94 @@
+#include "registry.hpp"
+
+#include <cassert>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+namespace common::exchange {
+namespace {
+/**
+ * @brief Owns the names behind the ids.
+ *
+ * Names are kept in deques, so the views handed out stay valid while new ids
+ * are added. Lookups take the lock as well: they run on other threads, e.g. the
+ * logger formatting an event, while a registration may grow a deque.
+ */
+class Registry final {
+public:
+    /**
+     * @brief A registered symbol.
+     */
+    struct Entry {
+        VenueId venue;    /**< Venue of the symbol. */
+        std::string name; /**< Exchange symbol name. */
+    };
+
+    static Registry& Instance() {
+        static Registry registry;
+        return registry;
+    }
+
+    VenueId AddVenue(std::string_view name) {
+        std::lock_guard lock{m_mutex};
+        for (std::size_t id = 0; id < m_venues.size(); ++id) {
+            if (m_venues[id] == name) {
+                return static_cast<VenueId>(id);
+            }
+        }
+        if (m_venues.size() == maxVenues) {
+            throw std::length_error{"Too many venues"};
+        }
+        m_venues.emplace_back(name);
+        return static_cast<VenueId>(m_venues.size() - 1);
+    }
+
+    SymbolId AddSymbol(VenueId venue, std::string_view name) {
+        std::lock_guard lock{m_mutex};
+        assert(venue < m_venues.size() && "Unknown venue");
+        for (std::size_t id = 0; id < m_symbols.size(); ++id) {
+            if (m_symbols[id].venue == venue && m_symbols[id].name == name) {
+                return static_cast<SymbolId>(id);
+            }
+        }
+        if (m_symbols.size() == maxSymbols) {
+            throw std::length_error{"Too many symbols"};
+        }
+        m_symbols.push_back({venue, std::string{name}});
+        return static_cast<SymbolId>(m_symbols.size() - 1);
+    }
+
+    std::string_view VenueName(VenueId id) const {
+        std::lock_guard lock{m_mutex};
+        return id < m_venues.size() ? std::string_view{m_venues[id]} : std::string_view{};
+    }
+
+    std::string_view SymbolName(SymbolId id) const {
+        std::lock_guard lock{m_mutex};
+        return id < m_symbols.size() ? std::string_view{m_symbols[id].name} : std::string_view{};
+    }
+
+private:
+    mutable std::mutex m_mutex;       /**< Guards both deques. */
+    std::deque<std::string> m_venues; /**< Venue names by id. */
+    std::deque<Entry> m_symbols;      /**< Symbols by id. */
+};
+}  // namespace
+
+VenueId RegisterVenue(std::string_view name) {
+    return Registry::Instance().AddVenue(name);
+}
+
+SymbolId RegisterSymbol(VenueId venue, std::string_view name) {
+    return Registry::Instance().AddSymbol(venue, name);
+}
+
+std::string_view VenueName(VenueId id) {
+    return Registry::Instance().VenueName(id);
+}
+
+std::string_view SymbolName(SymbolId id) {
+    return Registry::Instance().SymbolName(id);
+}
+}  // namespace common::exchange
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+namespace common::exchange {
+
+/**
+ * @brief Dense id of a venue, assigned in registration order from 0.
+ */
+using VenueId = uint8_t;
+
+/**
+ * @brief Dense id of a symbol of a venue, assigned in registration order from 0.
+ */
+using SymbolId = uint16_t;
+
+static constexpr std::size_t maxVenues = std::numeric_limits<VenueId>::max() + 1;
+static constexpr std::size_t maxSymbols = std::numeric_limits<SymbolId>::max() + 1;
+
+/**
+ * @brief Registers a venue name, returning its id.
+ *
+ * Registering a name again returns the same id. Venues and symbols are usually
+ * registered at startup, when serializers are created. Registration and lookups
+ * may be called from any thread.
+ *
+ * @param name Venue name, e.g. "binance". The name is copied.
+ * @return The id of the venue.
+ * @throws std::length_error if all maxVenues ids are taken.
+ */
+VenueId RegisterVenue(std::string_view name);
+
+/**
+ * @brief Registers a symbol of a venue, returning its id.
+ *
+ * Symbol ids are unique across venues, so a symbol id alone identifies the market.
+ * Registering the same venue and name again returns the same id.
+ *
+ * @param venue Id returned by RegisterVenue().
+ * @param name Exchange symbol name, e.g. "ethusdt". The name is copied.
+ * @return The id of the symbol.
+ * @throws std::length_error if all maxSymbols ids are taken.
+ */
+SymbolId RegisterSymbol(VenueId venue, std::string_view name);
+
+/**
+ * @brief Returns the name of a venue, empty if the id is not registered.
+ *
+ * The view stays valid for the lifetime of the process.
+ */
+std::string_view VenueName(VenueId id);
+
+/**
+ * @brief Returns the name of a symbol, empty if the id is not registered.
+ *
+ * The view stays valid for the lifetime of the process.
+ */
+std::string_view SymbolName(SymbolId id);
+
+}  // namespace common::exchange
@@ -1,39 +1,112 @@
 #include "ac.hpp"
 
 #include <Eigen/Dense>
+#include <cmath>
+#include <common/decimal/decimal.hpp>
+#include <core/metrics/latency.hpp>
+#include <stdexcept>
 
 namespace core::algorithm {
-void AlmgrenChrissTracker::AddEvent(const common::event::NormalizedEvent& e) {
-    if (e.source == common::event::Source::Depth) {
-        if (!m_initialized) {
-            m_bestBid = e.type == common::event::Type::Bid ? e.price : m_bestBid;
-            m_bestAsk = e.type == common::event::Type::Ask ? e.price : m_bestAsk;
-            m_lastMid = (m_bestBid + m_bestAsk) * 0.5;
-            m_initialized = true;
-        } else {
-            if (e.type == common::event::Type::Bid)
-                m_bestBid = e.price;
-            if (e.type == common::event::Type::Ask)
-                m_bestAsk = e.price;
+namespace cd = common::decimal;
+
+AlmgrenChrissTracker::AlmgrenChrissTracker(const common::exchange::SymbolParams& symbol,
+                                           const ACConfig& config)
+    : m_symbol(symbol), m_config(config) {
+    if (m_config.mode == ACMode::Window) {
+        if (m_config.windowSize == 0) {
+            throw std::invalid_argument{"AC window size must be positive"};
         }
-        m_midPrice = (m_bestBid + m_bestAsk) * 0.5;
-    } else if (e.source == common::event::Source::Trade && m_initialized) {
-        float delta = m_midPrice - m_lastMid;
-        float sign = e.type == common::event::Type::Bid ? 1.0 : -1.0;
-        float signed_vol = e.size * sign;
-        m_cumSignedVol += signed_vol;
+        m_window.resize(m_config.windowSize);
+    } else if (m_config.mode == ACMode::Exponential && m_config.halfLife.count() <= 0) {
+        throw std::invalid_argument{"AC half-life must be positive"};
+    }
+}
 
-        m_data.emplace_back(delta, signed_vol, m_cumSignedVol);
+void AlmgrenChrissTracker::UpdateBook(const OrderBook& book) {
+    using Side = OrderBook::Side;
+    if (book.Empty(Side::Bid) || book.Empty(Side::Ask)) {
+        return;
+    }
 
+    const auto top = book.Best(Side::Bid).price + book.Best(Side::Ask).price;
+    m_midPrice = cd::ToDouble(top, m_symbol.priceDecimals) * 0.5;
+    if (!m_initialized) {
         m_lastMid = m_midPrice;
+        m_initialized = true;
     }
 }
 
+void AlmgrenChrissTracker::AddEvent(const common::event::NormalizedEvent& e) {
+    if (e.source != common::event::Source::Trade || !m_initialized) {
+        return;
+    }
+
+    const auto delta = static_cast<float>(m_midPrice - m_lastMid);
+    const int64_t signedVol = e.type == common::event::Type::Bid ? e.size : -e.size;
+    m_cumSignedVol += signedVol;
+
+    const auto sizeDecimals = m_symbol.sizeDecimals;
+    const ACDataPoint point{delta, static_cast<float>(cd::ToDouble(signedVol, sizeDecimals)),
+                            static_cast<float>(cd::ToDouble(m_cumSignedVol, sizeDecimals))};
+    // exchange time keeps windows stable across replays, the receive time is the fallback
+    const auto tsUs = e.exchangeTsUs != 0 ? e.exchangeTsUs : e.recvTsUs;
+    switch (m_config.mode) {
+        case ACMode::Batch:
+            m_data.push_back(point);
+            ++m_count;
+            break;
+        case ACMode::Online:
+            m_moments.Add(point);
+            ++m_count;
+            break;
+        case ACMode::Window:
+            PushWindow(tsUs, point);
+            break;
+        case ACMode::Exponential:
+            PushExponential(tsUs, point);
+            break;
+    }
+
+    m_lastMid = m_midPrice;
+}
+
+void AlmgrenChrissTracker::ClearEvents() {
+    if (m_config.mode == ACMode::Batch || m_config.mode == ACMode::Online) {
+        m_data.clear();
+        m_moments = {};
+        m_count = 0;
+    }
+}
+
+void AlmgrenChrissTracker::Reset() {
+    m_data.clear();
+    m_moments = {};
+    m_count = 0;
+    m_head = 0;
+    m_sinceRebuild = 0;
+    m_lastTsUs = 0;
+    m_midPrice = 0;
+    m_lastMid = 0;
+    m_cumSignedVol = 0;
+    m_initialized = false;
+}
+
 ACResult AlmgrenChrissTracker::ComputeRegression() const {
-    if (m_data.empty()) {
+    const metrics::ScopedLatency latency{metrics::Stage::Regression};
+    if (m_count == 0) {
         return {};
     }
 
+    if (m_config.mode != ACMode::Batch) {
+        const auto& [xtx, xty] = m_moments;
+        Eigen::Matrix2d a;
+        a << xtx[0], xtx[1], xtx[1], xtx[2];
+        const Eigen::Vector2d b{xty[0], xty[1]};
+
+        const Eigen::Vector2d beta = a.ldlt().solve(b);
+        return ACResult{beta(0), beta(1)};
+    }
+
     size_t N = m_data.size();
     Eigen::MatrixXd X(N, 2);
     Eigen::VectorXd y(N);
@@ -48,4 +121,75 @@ ACResult AlmgrenChrissTracker::ComputeRegression() const {
 
     return ACResult{beta(0), beta(1)};
 }
+
+void AlmgrenChrissTracker::PushWindow(uint64_t tsUs, const ACDataPoint& point) noexcept {
+    const auto capacity = m_window.size();
+    const auto span = static_cast<uint64_t>(m_config.windowSpan.count());
+
+    const auto evictOldest = [this, capacity] {
+        m_moments.Add(m_window[m_head].point, -1);
+        m_head = (m_head + 1) % capacity;
+        --m_count;
+    };
+
+    // an out-of-order trade older than the head evicts nothing instead of wrapping around
+    if (span != 0) {
+        while (m_count != 0 && tsUs > m_window[m_head].tsUs &&
+               tsUs - m_window[m_head].tsUs > span) {
+            evictOldest();
+        }
+    }
+    if (m_count == capacity) {
+        evictOldest();
+    }
+
+    m_window[(m_head + m_count) % capacity] = Sample{tsUs, point};
+    ++m_count;
+
+    if (++m_sinceRebuild < capacity) {
+        m_moments.Add(point);
+        return;
+    }
+
+    // subtracting evicted points accumulates rounding errors, start over from the ring
+    m_moments = {};
+    for (std::size_t i = 0; i < m_count; ++i) {
+        m_moments.Add(m_window[(m_head + i) % capacity].point);
+    }
+    m_sinceRebuild = 0;
+}
+
+void AlmgrenChrissTracker::PushExponential(uint64_t tsUs, const ACDataPoint& point) noexcept {
+    if (m_count != 0 && tsUs > m_lastTsUs) {
+        const auto elapsed = static_cast<double>(tsUs - m_lastTsUs);
+        m_moments.Scale(std::exp2(-elapsed / static_cast<double>(m_config.halfLife.count())));
+    }
+    if (m_count == 0 || tsUs > m_lastTsUs) {
+        m_lastTsUs = tsUs;
+    }
+
+    m_moments.Add(point);
+    ++m_count;
+}
+
+void AlmgrenChrissTracker::Moments::Add(const ACDataPoint& point, double weight) noexcept {
+    const double x0 = point.signed_volume;
+    const double x1 = point.cum_signed_volume;
+    const double y = point.delta_mid;
+
+    xtx[0] += weight * x0 * x0;
+    xtx[1] += weight * x0 * x1;
+    xtx[2] += weight * x1 * x1;
+    xty[0] += weight * x0 * y;
+    xty[1] += weight * x1 * y;
+}
+
+void AlmgrenChrissTracker::Moments::Scale(double factor) noexcept {
+    for (auto& v : xtx) {
+        v *= factor;
+    }
+    for (auto& v : xty) {
+        v *= factor;
+    }
+}
 }  // namespace core::algorithm
@@ -1,8 +1,15 @@
 #pragma once
 
 #include <common/event/normalized_event.hpp>
+#include <array>
+#include <chrono>
+#include <common/exchange/exchange_params.hpp>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
+#include "order_book.hpp"
+
 namespace core::algorithm {
 
 /**
@@ -27,29 +34,96 @@ struct ACResult {
     double phiPerm;   /**< Permanent impact coefficient (φ_perm). */
 };
 
+/**
+ * @brief How the Almgren–Chriss regression is computed.
+ */
+enum class ACMode {
+    Batch,       /**< Keep every data point and solve the regression over all of them. */
+    Online,      /**< Keep only the running XᵀX and Xᵀy; O(1) time and memory per trade. */
+    Window,      /**< Regression over the last trades of a count- and/or time-bounded window. */
+    Exponential, /**< Exponentially-weighted regression with a half-life in time. */
+};
+
+/**
+ * @brief Configuration of the Almgren–Chriss tracker.
+ */
+struct ACConfig {
+    ACMode mode = ACMode::Online;                                /**< Regression mode. */
+    std::size_t windowSize = 1024;                               /**< Window: max trades. */
+    std::chrono::microseconds windowSpan{0};                     /**< Window: max age, 0 = any. */
+    std::chrono::microseconds halfLife{std::chrono::seconds{5}}; /**< Exponential: half-life. */
+};
+
 /**
  * @brief Tracks market events and computes Almgren–Chriss model parameters.
  *
- * The class collects normalized market events, derives microstructure data points,
- * and performs regression analysis to estimate impact coefficients.
+ * The class tracks the mid price of the symbol's order book, collects trades,
+ * derives microstructure data points, and performs regression analysis to estimate
+ * impact coefficients.
+ *
+ * Except for the batch mode, data points are folded into the sufficient statistics
+ * of the least-squares fit (XᵀX and Xᵀy) as they arrive, so the regression is a 2×2
+ * solve regardless of how many trades were seen:
+ * - Online accumulates everything since the last ClearEvents().
+ * - Window keeps the trades of the window in a ring preallocated at construction and
+ *   subtracts the ones that leave it. The sums are rebuilt from the ring once per
+ *   window length to bound the rounding drift of the subtractions.
+ * - Exponential decays the sums by 2^(-Δt / halfLife) between trades.
+ *
+ * Window and Exponential estimates are meant to persist, so ClearEvents() does not
+ * affect them; Reset() drops the state of every mode.
  */
 class AlmgrenChrissTracker final {
 public:
+    /**
+     * @brief Constructs a tracker for a symbol.
+     *
+     * @param symbol Symbol parameters defining the fixed-point scale of events.
+     * @param config Regression mode and its parameters.
+     * @throws std::invalid_argument if the window size or the half-life is zero.
+     */
+    explicit AlmgrenChrissTracker(const common::exchange::SymbolParams& symbol,
+                                  const ACConfig& config = {});
+
+    /**
+     * @brief Reads the current mid price from the top of the order book.
+     *
+     * @param book The order book of the symbol.
+     */
+    void UpdateBook(const OrderBook& book);
+
     /**
      * @brief Adds a new normalized market event for processing.
      *
+     * Only trades produce data points; depth is taken from the book via UpdateBook().
+     *
      * @param e The normalized event to be added.
      */
     void AddEvent(const common::event::NormalizedEvent& e);
 
     /**
-     * @brief Clears all stored data points and resets internal state.
+     * @brief Ends the current estimation period.
+     *
+     * Clears the collected data points in the batch and online modes; the sliding
+     * window and exponentially-weighted estimates carry over.
      */
-    inline void ClearEvents() { m_data.clear(); }
+    void ClearEvents();
+
+    /**
+     * @brief Drops all data points and the tracked mid price in every mode.
+     */
+    void Reset();
+
+    /**
+     * @brief Returns the number of data points in the current regression.
+     */
+    inline std::size_t Size() const noexcept { return m_count; }
 
     /**
      * @brief Returns the collected data points used for regression.
      *
+     * Data points are kept in the batch mode only.
+     *
      * @return Const reference to the vector of data points.
      */
     inline const std::vector<ACDataPoint>& GetData() const noexcept { return m_data; }
@@ -62,13 +136,58 @@ public:
     ACResult ComputeRegression() const;
 
 private:
-    std::vector<ACDataPoint> m_data; /**< Collected data points for regression. */
+    /**
+     * @brief Sufficient statistics of the least-squares fit.
+     */
+    struct Moments {
+        std::array<double, 3> xtx{}; /**< XᵀX (upper triangle: xx00, xx01, xx11). */
+        std::array<double, 2> xty{}; /**< Xᵀy. */
+
+        /**
+         * @brief Adds a data point with a weight (a negative weight removes it).
+         */
+        void Add(const ACDataPoint& point, double weight = 1) noexcept;
+
+        /**
+         * @brief Multiplies all sums by a factor.
+         */
+        void Scale(double factor) noexcept;
+    };
+
+    /**
+     * @brief A data point of the sliding window.
+     */
+    struct Sample {
+        uint64_t tsUs;     /**< Trade timestamp in microseconds. */
+        ACDataPoint point; /**< Data point of the trade. */
+    };
+
+    /**
+     * @brief Pushes a data point into the sliding window, evicting expired ones.
+     */
+    void PushWindow(uint64_t tsUs, const ACDataPoint& point) noexcept;
+
+    /**
+     * @brief Decays the sums to `tsUs` and adds a data point.
+     */
+    void PushExponential(uint64_t tsUs, const ACDataPoint& point) noexcept;
+
+private:
+    common::exchange::SymbolParams m_symbol; /**< Symbol parameters (fixed-point scale). */
+    ACConfig m_config;                       /**< Regression mode and its parameters. */
+    std::vector<ACDataPoint> m_data;         /**< Collected data points (batch mode). */
+
+    Moments m_moments;       /**< Running sums (all modes except batch). */
+    std::size_t m_count = 0; /**< Number of data points in the regression. */
+
+    std::vector<Sample> m_window;   /**< Window ring, preallocated to the window size. */
+    std::size_t m_head = 0;         /**< Index of the oldest sample in the ring. */
+    std::size_t m_sinceRebuild = 0; /**< Samples pushed since the sums were rebuilt. */
+    uint64_t m_lastTsUs = 0;        /**< Timestamp of the last exponentially-weighted trade. */
 
-    float m_bestBid = 0;      /**< Current best bid price. */
-    float m_bestAsk = 0;      /**< Current best ask price. */
-    float m_midPrice = 0;     /**< Current mid-price (average of bid and ask). */
-    float m_lastMid = 0;      /**< Previous mid-price used for delta computation. */
-    float m_cumSignedVol = 0; /**< Cumulative signed trade volume. */
+    double m_midPrice = 0;      /**< Current mid-price (average of bid and ask). */
+    double m_lastMid = 0;       /**< Previous mid-price used for delta computation. */
+    int64_t m_cumSignedVol = 0; /**< Cumulative signed trade volume in lots. */
 
     bool m_initialized = false; /**< Indicates whether the tracker has received initial data. */
 };
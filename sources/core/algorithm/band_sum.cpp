@@ -0,0 +1,170 @@
+#include "band_sum.hpp"
+
+#include <cassert>
+#include <cstddef>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define BAND_SUM_X86 1
+#endif
+
+namespace core::algorithm {
+namespace {
+using BandSum = OrderBook::BandSum;
+
+/**
+ * @brief Portable kernel, also used for the tail of the vector kernels.
+ */
+BandSum SumScalar(const common::event::EventColumns& columns, std::size_t from, bool bid,
+                  int64_t limit) noexcept {
+    BandSum sum{0, 0};
+    for (auto i = from; i < columns.Size(); ++i) {
+        const auto price = columns.price[i];
+        const bool within = bid ? columns.IsBid(i) && price >= limit
+                                : !columns.IsBid(i) && price <= limit;
+        const int64_t mask = -static_cast<int64_t>(within);
+        sum.notional += (price * columns.size[i]) & mask;
+        sum.volume += columns.size[i] & mask;
+    }
+    return sum;
+}
+
+#ifdef BAND_SUM_X86
+/**
+ * @brief Low 64 bits of the lane-wise product, AVX2 has no 64-bit multiply.
+ */
+__attribute__((target("avx2"))) inline __m256i Mul64(__m256i a, __m256i b) noexcept {
+    const __m256i lo = _mm256_mul_epu32(a, b);
+    const __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+                                           _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+    return _mm256_add_epi64(lo, _mm256_slli_epi64(cross, 32));
+}
+
+__attribute__((target("avx2"))) inline int64_t Horizontal(__m256i v) noexcept {
+    const __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    return _mm_cvtsi128_si64(sum) + _mm_extract_epi64(sum, 1);
+}
+
+__attribute__((target("avx2"))) BandSum SumAvx2(const common::event::EventColumns& columns,
+                                                 bool bid, int64_t limit) noexcept {
+    const auto n = columns.Size();
+    const __m256i lanes = _mm256_setr_epi64x(1, 2, 4, 8);
+    const __m256i edge = _mm256_set1_epi64x(limit);
+    // lanes of the other side are masked by their bit being equal to zero
+    const __m256i sideBit = bid ? lanes : _mm256_setzero_si256();
+    __m256i notional = _mm256_setzero_si256();
+    __m256i volume = _mm256_setzero_si256();
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const auto* price = reinterpret_cast<const __m256i*>(columns.price.data() + i);
+        const auto* size = reinterpret_cast<const __m256i*>(columns.size.data() + i);
+        const __m256i p = _mm256_loadu_si256(price);
+        const __m256i s = _mm256_loadu_si256(size);
+
+        const auto bits = static_cast<int64_t>((columns.bids[i / 64] >> (i % 64)) & 0xf);
+        const __m256i side =
+            _mm256_cmpeq_epi64(_mm256_and_si256(_mm256_set1_epi64x(bits), lanes), sideBit);
+        // bids: !(limit > price), asks: !(price > limit)
+        const __m256i outside = bid ? _mm256_cmpgt_epi64(edge, p) : _mm256_cmpgt_epi64(p, edge);
+        const __m256i mask = _mm256_andnot_si256(outside, side);
+
+        notional = _mm256_add_epi64(notional, _mm256_and_si256(Mul64(p, s), mask));
+        volume = _mm256_add_epi64(volume, _mm256_and_si256(s, mask));
+    }
+
+    auto sum = SumScalar(columns, i, bid, limit);
+    sum.notional += Horizontal(notional);
+    sum.volume += Horizontal(volume);
+    return sum;
+}
+
+/**
+ * @brief Low 64 bits of the lane-wise product, SSE has no 64-bit multiply.
+ */
+__attribute__((target("sse4.2"))) inline __m128i Mul64(__m128i a, __m128i b) noexcept {
+    const __m128i lo = _mm_mul_epu32(a, b);
+    const __m128i cross = _mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), b),
+                                        _mm_mul_epu32(a, _mm_srli_epi64(b, 32)));
+    return _mm_add_epi64(lo, _mm_slli_epi64(cross, 32));
+}
+
+__attribute__((target("sse4.2"))) BandSum SumSse42(const common::event::EventColumns& columns,
+                                                   bool bid, int64_t limit) noexcept {
+    const auto n = columns.Size();
+    const __m128i lanes = _mm_set_epi64x(2, 1);
+    const __m128i edge = _mm_set1_epi64x(limit);
+    const __m128i sideBit = bid ? lanes : _mm_setzero_si128();
+    __m128i notional = _mm_setzero_si128();
+    __m128i volume = _mm_setzero_si128();
+
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        const auto* price = reinterpret_cast<const __m128i*>(columns.price.data() + i);
+        const auto* size = reinterpret_cast<const __m128i*>(columns.size.data() + i);
+        const __m128i p = _mm_loadu_si128(price);
+        const __m128i s = _mm_loadu_si128(size);
+
+        const auto bits = static_cast<int64_t>((columns.bids[i / 64] >> (i % 64)) & 0x3);
+        const __m128i side =
+            _mm_cmpeq_epi64(_mm_and_si128(_mm_set1_epi64x(bits), lanes), sideBit);
+        const __m128i outside = bid ? _mm_cmpgt_epi64(edge, p) : _mm_cmpgt_epi64(p, edge);
+        const __m128i mask = _mm_andnot_si128(outside, side);
+
+        notional = _mm_add_epi64(notional, _mm_and_si128(Mul64(p, s), mask));
+        volume = _mm_add_epi64(volume, _mm_and_si128(s, mask));
+    }
+
+    auto sum = SumScalar(columns, i, bid, limit);
+    sum.notional += _mm_cvtsi128_si64(notional) + _mm_extract_epi64(notional, 1);
+    sum.volume += _mm_cvtsi128_si64(volume) + _mm_extract_epi64(volume, 1);
+    return sum;
+}
+#endif
+
+Isa DetectIsa() noexcept {
+#ifdef BAND_SUM_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return Isa::Avx2;
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+        return Isa::Sse42;
+    }
+#endif
+    return Isa::Scalar;
+}
+
+const Isa bestIsa = DetectIsa(); /**< Kernel of the running CPU. */
+}  // namespace
+
+Isa BestIsa() noexcept {
+    return bestIsa;
+}
+
+bool Supported(Isa isa) noexcept {
+    return isa <= bestIsa;
+}
+
+OrderBook::BandSum SumBand(const common::event::EventColumns& columns, OrderBook::Side side,
+                           int64_t limit, Isa isa) {
+    assert(Supported(isa) && "Kernel is not supported by the CPU");
+    const bool bid = side == OrderBook::Side::Bid;
+
+    switch (isa) {
+#ifdef BAND_SUM_X86
+        case Isa::Avx2:
+            return SumAvx2(columns, bid, limit);
+        case Isa::Sse42:
+            return SumSse42(columns, bid, limit);
+#endif
+        default:
+            return SumScalar(columns, 0, bid, limit);
+    }
+}
+
+OrderBook::BandSum SumBand(const common::event::EventColumns& columns, OrderBook::Side side,
+                           int64_t limit) {
+    return SumBand(columns, side, limit, bestIsa);
+}
+}  // namespace core::algorithm
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <common/event/event_columns.hpp>
+#include <cstdint>
+
+#include "order_book.hpp"
+
+namespace core::algorithm {
+
+/**
+ * @brief Instruction sets of the band sum kernels.
+ */
+enum class Isa {
+    Scalar, /**< Portable fallback. */
+    Sse42,  /**< Two events per step (SSE4.2 for the 64-bit compare). */
+    Avx2    /**< Four events per step. */
+};
+
+/**
+ * @brief Returns the best kernel the CPU supports, detected once at startup.
+ */
+Isa BestIsa() noexcept;
+
+/**
+ * @brief Checks whether the CPU can run a kernel.
+ *
+ * @param isa Instruction set of the kernel.
+ */
+bool Supported(Isa isa) noexcept;
+
+/**
+ * @brief Returns the total notional and volume of the levels of a side within `limit`.
+ *
+ * The same band as OrderBook::Sum(), computed straight from a depth snapshot: for
+ * bids the levels priced at or above the limit, for asks at or below it. The kernel
+ * masks every event by its side and price and accumulates size and price × size
+ * in exact 64-bit integer arithmetic, so all kernels return the same totals.
+ *
+ * @param columns Levels of a depth snapshot; trades would count as asks.
+ * @param side Book side, Bid or Ask.
+ * @param limit Band edge price in ticks.
+ * @param isa Kernel to use, must be Supported().
+ */
+OrderBook::BandSum SumBand(const common::event::EventColumns& columns, OrderBook::Side side,
+                           int64_t limit, Isa isa);
+
+/**
+ * @brief Same as above, with the kernel of BestIsa().
+ */
+OrderBook::BandSum SumBand(const common::event::EventColumns& columns, OrderBook::Side side,
+                           int64_t limit);
+
+}  // namespace core::algorithm
@@ -0,0 +1,76 @@
+#include "order_book.hpp"
+
+#include <algorithm>
+
+namespace core::algorithm {
+void OrderBook::Apply(const event_t& event) {
+    if (event.source != common::event::Source::Depth || event.type == Side::Unspecified) {
+        return;
+    }
+
+    if (event.level == 0) {
+        Clear(event.type);
+    }
+    Update(event.type, event.price, event.size);
+}
+
+void OrderBook::Update(Side side, int64_t price, int64_t size) {
+    auto& book = Book(side);
+    auto& levels = book.levels;
+    const auto idx = LowerBound(side, price);
+    const auto it = levels.begin() + static_cast<std::ptrdiff_t>(idx);
+    const bool exists = it != levels.end() && it->price == price;
+
+    if (size == 0) {
+        if (exists) {
+            levels.erase(it);
+        }
+    } else if (exists) {
+        it->size = size;
+    } else {
+        levels.insert(it, Level{price, size});
+    }
+
+    // prefix[idx] covers levels below idx only, so it stays valid
+    book.valid = std::min(book.valid, idx);
+}
+
+std::span<const OrderBook::Level> OrderBook::Band(Side side, int64_t limit) const noexcept {
+    const auto& levels = Levels(side);
+    const auto idx = LowerBound(side, limit);
+    return std::span<const Level>{levels}.subspan(idx);
+}
+
+OrderBook::BandSum OrderBook::Sum(Side side, int64_t limit) const {
+    const auto& book = Book(side);
+    const auto& levels = book.levels;
+    auto& prefix = book.prefix;
+
+    if (book.valid < levels.size() || prefix.size() != levels.size() + 1) {
+        prefix.resize(levels.size() + 1);
+        if (book.valid == 0) {
+            prefix[0] = BandSum{0, 0};
+        }
+        for (auto i = book.valid; i < levels.size(); ++i) {
+            prefix[i + 1] = BandSum{prefix[i].notional + levels[i].price * levels[i].size,
+                                    prefix[i].volume + levels[i].size};
+        }
+        book.valid = levels.size();
+    }
+
+    const auto& total = prefix.back();
+    const auto& deeper = prefix[LowerBound(side, limit)];
+    return BandSum{total.notional - deeper.notional, total.volume - deeper.volume};
+}
+
+std::size_t OrderBook::LowerBound(Side side, int64_t price) const noexcept {
+    const auto& levels = Levels(side);
+
+    // Bids are ascending and asks are descending, "deeper" means cheaper bid or pricier ask.
+    const auto it =
+        side == Side::Bid
+            ? std::ranges::lower_bound(levels, price, std::less{}, &Level::price)
+            : std::ranges::lower_bound(levels, price, std::greater{}, &Level::price);
+    return static_cast<std::size_t>(it - levels.begin());
+}
+}  // namespace core::algorithm
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <common/event/normalized_event.hpp>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace core::algorithm {
+
+/**
+ * @brief Per-symbol L2 order book on flat, price-sorted arrays.
+ *
+ * Each side is a contiguous array of price levels ordered from the deepest level
+ * to the top of book, i.e. the best price is the last element. Updates near the
+ * top of book, which dominate market data, therefore move only a few elements,
+ * the best level is read in O(1), and every depth band around the top is a
+ * contiguous tail of the array. Prices and sizes are fixed-point integers
+ * (see common/decimal/decimal.hpp).
+ *
+ * Every side also keeps prefix sums of size and price×size from the deepest level
+ * up, so the totals of any band are a binary search plus a subtraction. Prefix sums
+ * are rebuilt lazily from the deepest modified level on the next query, which for
+ * top-of-book updates touches only a handful of entries.
+ */
+class OrderBook final {
+public:
+    using event_t = common::event::NormalizedEvent; /**< Alias for the normalized event type. */
+    using Side = common::event::Type;               /**< Book side (Bid or Ask). */
+
+    /**
+     * @brief A single aggregated price level.
+     */
+    struct Level {
+        int64_t price; /**< Level price in ticks. */
+        int64_t size;  /**< Aggregated size in lots. */
+    };
+
+    /**
+     * @brief Totals over a set of levels.
+     */
+    struct BandSum {
+        int64_t notional; /**< Sum of price × size, in ticks × lots. */
+        int64_t volume;   /**< Sum of size, in lots. */
+    };
+
+    /**
+     * @brief Applies a depth event to the book.
+     *
+     * Depth feeds publish partial-book snapshots, so an event for level 0 starts
+     * a new snapshot of its side and drops the previous levels of that side.
+     * Events of other sources or without a side are ignored.
+     *
+     * @param event The normalized depth event.
+     */
+    void Apply(const event_t& event);
+
+    /**
+     * @brief Updates, inserts or deletes (size 0) a price level in place.
+     *
+     * @param side Book side.
+     * @param price Level price in ticks.
+     * @param size New level size in lots, 0 removes the level.
+     */
+    void Update(Side side, int64_t price, int64_t size);
+
+    /**
+     * @brief Removes all levels of a side.
+     *
+     * @param side Book side.
+     */
+    inline void Clear(Side side) noexcept {
+        auto& book = Book(side);
+        book.levels.clear();
+        book.valid = 0;
+    }
+
+    /**
+     * @brief Removes all levels of both sides.
+     */
+    inline void Clear() noexcept {
+        Clear(Side::Bid);
+        Clear(Side::Ask);
+    }
+
+    /**
+     * @brief Checks whether a side has no levels.
+     *
+     * @param side Book side.
+     */
+    inline bool Empty(Side side) const noexcept { return Levels(side).empty(); }
+
+    /**
+     * @brief Returns the top-of-book level of a side. The side must not be empty.
+     *
+     * @param side Book side.
+     */
+    inline const Level& Best(Side side) const noexcept { return Levels(side).back(); }
+
+    /**
+     * @brief Returns all levels of a side, from the deepest one to the top of book.
+     *
+     * @param side Book side.
+     */
+    inline std::span<const Level> Depth(Side side) const noexcept { return Levels(side); }
+
+    /**
+     * @brief Returns the levels of a side whose price is within `limit`.
+     *
+     * For bids these are levels priced at or above the limit, for asks at or below it.
+     * Levels are ordered from the band edge to the top of book.
+     *
+     * @param side Book side.
+     * @param limit Band edge price in ticks.
+     */
+    std::span<const Level> Band(Side side, int64_t limit) const noexcept;
+
+    /**
+     * @brief Returns the total notional and volume of the levels within `limit`.
+     *
+     * Equivalent to summing Band(side, limit), computed from prefix sums.
+     *
+     * @param side Book side.
+     * @param limit Band edge price in ticks.
+     */
+    BandSum Sum(Side side, int64_t limit) const;
+
+private:
+    /**
+     * @brief Levels of one side with their lazily maintained prefix sums.
+     */
+    struct SideBook {
+        std::vector<Level> levels;           /**< Levels, best level last. */
+        mutable std::vector<BandSum> prefix; /**< prefix[i] is the total of levels [0, i). */
+        mutable std::size_t valid = 0;       /**< prefix[0..valid] are up to date. */
+    };
+
+    inline SideBook& Book(Side side) noexcept { return side == Side::Bid ? m_bids : m_asks; }
+
+    inline const SideBook& Book(Side side) const noexcept {
+        return side == Side::Bid ? m_bids : m_asks;
+    }
+
+    inline std::vector<Level>& Levels(Side side) noexcept { return Book(side).levels; }
+
+    inline const std::vector<Level>& Levels(Side side) const noexcept {
+        return Book(side).levels;
+    }
+
+    /**
+     * @brief Returns the index of the first level that is not deeper than `price`.
+     */
+    std::size_t LowerBound(Side side, int64_t price) const noexcept;
+
+private:
+    SideBook m_bids; /**< Bid levels, ascending by price (best bid last). */
+    SideBook m_asks; /**< Ask levels, descending by price (best ask last). */
+};
+
+}  // namespace core::algorithm
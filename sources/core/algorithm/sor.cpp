@@ -2,6 +2,7 @@
 
 #include <Eigen/Dense>
 #include <core/log/log.hpp>
+#include <core/metrics/latency.hpp>
 
 namespace core::algorithm {
 static inline float ComputeVarCost(float gammaTemp, float phiPerm, float volume) {
@@ -9,6 +10,7 @@ static inline float ComputeVarCost(float gammaTemp, float phiPerm, float volume)
 }
 
 void SOR::Compute(std::vector<VenueData>& venues) const {
+    const metrics::ScopedLatency latency{metrics::Stage::Sor};
     size_t N = venues.size();
     if (N == 0) {
         return;
@@ -1,58 +1,96 @@
 #include "vwap.hpp"
 
 #include <algorithm>
-#include <array>
+#include <cmath>
+#include <common/decimal/decimal.hpp>
 #include <core/log/log.hpp>
+#include <core/metrics/latency.hpp>
+#include <optional>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
+#include "band_sum.hpp"
+
 namespace core::algorithm {
-std::vector<VWAP::Result> VWAP::Compute(float takerFee) {
-    using event_t = common::event::NormalizedEvent;
-    static constexpr std::array<float, 3> percents = {0.01, 0.02, 0.05};
-    std::vector<VWAP::Result> results;
-    results.reserve(3);
-
-    if (m_asks.empty() || m_bids.empty()) {
-        return {};
+VWAP::VWAP(const common::exchange::SymbolParams& symbol, std::vector<float> bands)
+    : m_symbol(symbol) {
+    SetBands(std::move(bands));
+}
+
+void VWAP::SetBands(std::vector<float> bands) {
+    if (std::ranges::any_of(bands, [](float band) { return !(band > 0); })) {
+        throw std::invalid_argument{"VWAP bands must be positive"};
     }
 
-    LOG(trace, "asks count: {}, bids count: {}", m_asks.size(), m_bids.size());
+    m_bands = std::move(bands);
+    m_results.clear();
+    m_results.reserve(m_bands.size());
+}
+
+const std::vector<VWAP::Result>& VWAP::Compute(const OrderBook& book, float takerFee) {
+    using Side = OrderBook::Side;
+    const metrics::ScopedLatency latency{metrics::Stage::Vwap};
+    m_results.clear();
 
-    std::ranges::sort(m_asks, [](event_t& lhs, event_t& rhs) { return lhs.price < rhs.price; });
-    std::ranges::sort(m_bids, [](event_t& lhs, event_t& rhs) { return lhs.price > rhs.price; });
+    if (book.Empty(Side::Ask) || book.Empty(Side::Bid)) {
+        return m_results;
+    }
 
-    float bestBid = m_bids.front().price;
-    float bestAsk = m_asks.front().price;
-    float mid = 0.5 * (bestBid + bestAsk);
-    LOG(trace, "Best bid: {}, Best ask: {}, mid: {}", bestBid, bestAsk, mid);
+    LOG(trace, "asks count: {}, bids count: {}", book.Depth(Side::Ask).size(),
+        book.Depth(Side::Bid).size());
 
-    for (auto percent : percents) {
-        float lower = mid * (1 - percent);
-        float upper = mid * (1 + percent);
+    return ComputeBands(book.Best(Side::Bid).price, book.Best(Side::Ask).price, takerFee,
+                        [&book](Side side, int64_t limit) { return book.Sum(side, limit); });
+}
 
-        float volBid = 0;
-        float sumBid = 0;
+const std::vector<VWAP::Result>& VWAP::Compute(const common::event::EventColumns& snapshot,
+                                               float takerFee) {
+    using Side = OrderBook::Side;
+    const metrics::ScopedLatency latency{metrics::Stage::Vwap};
+    m_results.clear();
 
-        for (const auto& b : m_bids) {
-            if (b.price < lower)
-                break;
-            volBid += b.size;
-            sumBid += b.price * b.size;
+    // level 0 of a side is its top of book
+    std::optional<int64_t> bestBid;
+    std::optional<int64_t> bestAsk;
+    for (std::size_t i = 0; i < snapshot.Size() && !(bestBid && bestAsk); ++i) {
+        if (snapshot.level[i] == 0) {
+            (snapshot.IsBid(i) ? bestBid : bestAsk) = snapshot.price[i];
         }
+    }
+    if (!bestBid || !bestAsk) {
+        return m_results;
+    }
+
+    return ComputeBands(*bestBid, *bestAsk, takerFee, [&snapshot](Side side, int64_t limit) {
+        return SumBand(snapshot, side, limit);
+    });
+}
 
-        float volAsk = 0;
-        float sumAsk = 0;
-        for (const auto& a : m_asks) {
-            if (a.price > upper)
-                break;
-            volAsk += a.size;
-            sumAsk += a.price * a.size;
+template <typename SumFn>
+const std::vector<VWAP::Result>& VWAP::ComputeBands(int64_t bestBid, int64_t bestAsk,
+                                                    float takerFee, SumFn&& sum) {
+    using Side = OrderBook::Side;
+    const double mid = 0.5 * static_cast<double>(bestBid + bestAsk);
+    LOG(trace, "Best bid: {}, Best ask: {}, mid: {}", bestBid, bestAsk, mid);
+
+    // notional / volume is in ticks, scale it back to a price
+    const auto vwap = [this, takerFee](const OrderBook::BandSum& band) -> float {
+        if (band.volume <= 0) {
+            return 0;
         }
+        const double price = static_cast<double>(band.notional) / static_cast<double>(band.volume);
+        return price / common::decimal::Pow10(m_symbol.priceDecimals) * (1 - takerFee);
+    };
+
+    for (auto percent : m_bands) {
+        const auto lower = static_cast<int64_t>(std::ceil(mid * (1 - percent)));
+        const auto upper = static_cast<int64_t>(std::floor(mid * (1 + percent)));
 
-        results.push_back({percent * 100, volBid > 0 ? (sumBid / volBid) * (1 - takerFee) : 0,
-                           volAsk > 0 ? (sumAsk / volAsk) * (1 - takerFee) : 0});
+        m_results.push_back(
+            {percent * 100, vwap(sum(Side::Bid, lower)), vwap(sum(Side::Ask, upper))});
     }
 
-    return results;
+    return m_results;
 }
 }  // namespace core::algorithm
@@ -1,65 +1,101 @@
 #pragma once
 
+#include <common/event/event_columns.hpp>
 #include <common/event/normalized_event.hpp>
+#include <cstdint>
 #include <common/exchange/exchange_params.hpp>
 #include <vector>
 
+#include "order_book.hpp"
+
 namespace core::algorithm {
 
 /**
  * @brief Computes VWAP (Volume-Weighted Average Price) metrics for bids and asks.
  *
- * The VWAP class accumulates normalized market events, groups them by side (bid/ask),
- * and calculates VWAP-based statistics that can be used for market analysis
- * or execution optimization.
+ * The VWAP class reads the L2 order book of a symbol and calculates VWAP-based
+ * statistics over depth bands around the mid price, which can be used for market
+ * analysis or execution optimization. Notional and volume of every band come from
+ * the prefix sums of the book, so the cost per band is a binary search per side and
+ * does not depend on the book depth. Only the resulting prices are converted to
+ * floating point.
+ *
+ * Partial book depth snapshots replace a whole side, so the bands can also be
+ * computed straight from the columns of a snapshot, without a book: every band is
+ * then a masked reduction over the levels, run by the SIMD kernel of the CPU
+ * (see band_sum.hpp).
  */
 class VWAP final {
 public:
-    using event_t = common::event::NormalizedEvent; /**< Alias for the normalized event type. */
-
     /**
      * @brief Result of the VWAP computation.
      */
     struct Result {
-        float percent; /**< Percentage of total traded volume at this price level. */
+        float percent; /**< Band width around the mid price, in percent. */
         float vwapBid; /**< Volume-weighted average bid price. */
         float vwapAsk; /**< Volume-weighted average ask price. */
     };
 
     /**
-     * @brief Adds a normalized event to the VWAP data set.
+     * @brief Constructs a VWAP calculator for a symbol.
      *
-     * Bid and ask events are separated internally for independent VWAP computation.
+     * @param symbol Symbol parameters defining the fixed-point scale of events.
+     * @param bands Band widths as fractions of the mid price (0.01 is ±1%).
+     */
+    VWAP(const common::exchange::SymbolParams& symbol, std::vector<float> bands);
+
+    /**
+     * @brief Replaces the set of bands.
      *
-     * @param event The normalized market event to be added.
+     * @param bands Band widths as fractions of the mid price; must be positive.
+     * @throws std::invalid_argument if a band is not positive.
      */
-    inline void AddEvent(const event_t& event) {
-        if (event.type == common::event::Type::Unspecified)
-            return;
-        event.type == common::event::Type::Bid ? m_bids.push_back(event) : m_asks.push_back(event);
-    }
+    void SetBands(std::vector<float> bands);
 
     /**
-     * @brief Clears all stored bid and ask events.
+     * @brief Returns the configured band widths.
      */
-    inline void ClearEvents() {
-        m_bids.clear();
-        m_asks.clear();
-    }
+    inline const std::vector<float>& GetBands() const noexcept { return m_bands; }
 
     /**
-     * @brief Computes VWAP statistics for the collected events.
+     * @brief Computes VWAP statistics over depth bands of the order book.
      *
      * Applies the taker fee adjustment when calculating effective VWAP values.
      *
+     * @param book The order book of the symbol.
+     * @param takerFee The taker fee rate applied to executed trades.
+     * @return One result per band, in the order of the bands, or an empty vector if
+     * either side of the book is empty. The reference is valid until the next call.
+     */
+    const std::vector<VWAP::Result>& Compute(const OrderBook& book, float takerFee);
+
+    /**
+     * @brief Computes VWAP statistics over depth bands of a depth snapshot.
+     *
+     * Gives the same results as Compute() on a book holding only the snapshot. The
+     * strategy keeps an incremental book and uses the overload above; this one is for
+     * consumers of whole snapshots parsed into columns, e.g. the benchmarks.
+     *
+     * @param snapshot Levels of one depth snapshot of both sides.
      * @param takerFee The taker fee rate applied to executed trades.
-     * @return A vector of VWAP computation results for different percentiles or aggregation levels.
+     * @return One result per band, in the order of the bands, or an empty vector if
+     * either side of the snapshot is empty. The reference is valid until the next call.
+     */
+    const std::vector<VWAP::Result>& Compute(const common::event::EventColumns& snapshot,
+                                             float takerFee);
+
+private:
+    /**
+     * @brief Fills the results from the band totals returned by `sum(side, limit)`.
      */
-    std::vector<VWAP::Result> Compute(float takerFee);
+    template <typename SumFn>
+    const std::vector<VWAP::Result>& ComputeBands(int64_t bestBid, int64_t bestAsk,
+                                                  float takerFee, SumFn&& sum);
 
 private:
-    std::vector<event_t> m_bids; /**< Stored bid-side events. */
-    std::vector<event_t> m_asks; /**< Stored ask-side events. */
+    common::exchange::SymbolParams m_symbol; /**< Symbol parameters (fixed-point scale). */
+    std::vector<float> m_bands;              /**< Band widths as fractions of the mid. */
+    std::vector<Result> m_results;           /**< Results of the last computation. */
 };
 
 }  // namespace core::algorithm
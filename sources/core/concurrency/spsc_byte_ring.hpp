@@ -0,0 +1,163 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#include "spsc_ring.hpp"
+
+namespace core::concurrency {
+
+/**
+ * @brief Bounded lock-free single-producer/single-consumer ring of variable-size records.
+ *
+ * Every record is a 8-byte size word followed by its payload, padded to 8 bytes, and
+ * is stored contiguously: a record that does not fit before the end of the buffer is
+ * preceded by a padding marker and starts over at the beginning. Records are written
+ * in place with Reserve()/Commit() and read in place with Front()/Pop().
+ *
+ * Exactly one thread may write and exactly one thread may read at a time. As in
+ * SpscRing, each side caches the other side's position and reloads it only when the
+ * ring looks full (or empty).
+ */
+class SpscByteRing final {
+public:
+    /**
+     * @brief Constructs a ring.
+     *
+     * @param capacity Minimum size in bytes, rounded up to a power of two.
+     */
+    explicit SpscByteRing(std::size_t capacity)
+        : m_buffer(std::bit_ceil(capacity < 64 ? std::size_t{64} : capacity)),
+          m_mask(m_buffer.size() - 1) {}
+
+    SpscByteRing(const SpscByteRing&) = delete;
+    SpscByteRing& operator=(const SpscByteRing&) = delete;
+
+    /**
+     * @brief Returns the size of the ring in bytes.
+     */
+    inline std::size_t Capacity() const noexcept { return m_buffer.size(); }
+
+    /**
+     * @brief Returns the largest payload a record may have.
+     */
+    inline std::size_t MaxRecord() const noexcept {
+        return m_buffer.size() / 2 - sizeof(uint64_t);
+    }
+
+    /**
+     * @brief Reserves space for a record to be written by the producer.
+     *
+     * The record becomes visible to the consumer after Commit().
+     *
+     * @param size Payload size in bytes, at most MaxRecord().
+     * @return Pointer to the payload (8-byte aligned), or nullptr if the ring is full.
+     */
+    std::byte* Reserve(std::size_t size) noexcept {
+        if (size > MaxRecord()) [[unlikely]] {
+            return nullptr;
+        }
+
+        const auto tail = m_tail.load(std::memory_order_relaxed);
+        const auto record = RecordSize(size);
+        const auto pos = tail & m_mask;
+        const auto contiguous = m_buffer.size() - pos;
+        const auto pad = contiguous < record ? contiguous : 0;
+
+        if (tail + pad + record - m_cachedHead > m_buffer.size()) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail + pad + record - m_cachedHead > m_buffer.size()) {
+                return nullptr;
+            }
+        }
+
+        if (pad != 0) {
+            WriteWord(pos, pad | paddingBit);
+        }
+        const auto start = (tail + pad) & m_mask;
+        WriteWord(start, size);
+        m_pending = pad + record;
+        return m_buffer.data() + start + sizeof(uint64_t);
+    }
+
+    /**
+     * @brief Publishes the record returned by the last Reserve().
+     */
+    inline void Commit() noexcept {
+        m_tail.store(m_tail.load(std::memory_order_relaxed) + m_pending,
+                     std::memory_order_release);
+    }
+
+    /**
+     * @brief Returns the payload of the oldest published record to the consumer.
+     *
+     * @return The payload, or an empty span if the ring is empty.
+     */
+    std::span<const std::byte> Front() noexcept {
+        for (;;) {
+            const auto head = m_head.load(std::memory_order_relaxed);
+            if (head == m_cachedTail) {
+                m_cachedTail = m_tail.load(std::memory_order_acquire);
+                if (head == m_cachedTail) {
+                    return {};
+                }
+            }
+
+            const auto pos = head & m_mask;
+            const auto word = ReadWord(pos);
+            if ((word & paddingBit) != 0) {
+                m_head.store(head + (word & ~paddingBit), std::memory_order_release);
+                continue;
+            }
+            m_frontSize = RecordSize(word);
+            return {m_buffer.data() + pos + sizeof(uint64_t), word};
+        }
+    }
+
+    /**
+     * @brief Releases the record returned by Front() back to the producer.
+     */
+    inline void Pop() noexcept {
+        m_head.store(m_head.load(std::memory_order_relaxed) + m_frontSize,
+                     std::memory_order_release);
+    }
+
+private:
+    static constexpr uint64_t paddingBit = 1ULL << 63; /**< Marks a skipped buffer tail. */
+
+    /**
+     * @brief Returns the size of a record including its size word and padding.
+     */
+    static constexpr std::size_t RecordSize(std::size_t size) noexcept {
+        return sizeof(uint64_t) + ((size + 7) & ~std::size_t{7});
+    }
+
+    inline void WriteWord(std::size_t pos, uint64_t word) noexcept {
+        std::memcpy(m_buffer.data() + pos, &word, sizeof(word));
+    }
+
+    inline uint64_t ReadWord(std::size_t pos) const noexcept {
+        uint64_t word;
+        std::memcpy(&word, m_buffer.data() + pos, sizeof(word));
+        return word;
+    }
+
+private:
+    std::vector<std::byte> m_buffer; /**< Record storage. */
+    std::size_t m_mask;              /**< Position mask (capacity - 1). */
+
+    alignas(cacheLine) std::atomic<std::size_t> m_head{0}; /**< Start of the oldest record. */
+    std::size_t m_cachedTail = 0;                          /**< Consumer's copy of m_tail. */
+    std::size_t m_frontSize = 0;                           /**< Size of the Front() record. */
+
+    alignas(cacheLine) std::atomic<std::size_t> m_tail{0}; /**< End of the newest record. */
+    std::size_t m_cachedHead = 0;                          /**< Producer's copy of m_head. */
+    std::size_t m_pending = 0;                             /**< Size of the Reserve() record. */
+};
+
+}  // namespace core::concurrency
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace core::concurrency {
+
+/**
+ * @brief Assumed size of a cache line, used to keep producer and consumer state apart.
+ */
+static constexpr std::size_t cacheLine = 64;
+
+/**
+ * @brief Bounded lock-free single-producer/single-consumer ring.
+ *
+ * Slots are allocated once at construction and reused, so slot types that own
+ * memory (e.g. a byte buffer) keep their capacity across pushes and the steady
+ * state does not allocate. Besides TryPush()/TryPop(), a slot can be filled and
+ * consumed in place with BeginPush()/EndPush() and Front()/Pop().
+ *
+ * Exactly one thread may push and exactly one thread may pop at a time. Each side
+ * keeps a cached copy of the other side's index and reloads the shared atomic
+ * only when the ring looks full (or empty), which keeps the cache line transfers
+ * off the fast path.
+ *
+ * @tparam T Slot type, must be default-constructible.
+ */
+template <typename T>
+class SpscRing final {
+public:
+    /**
+     * @brief Constructs a ring.
+     *
+     * @param capacity Minimum number of slots, rounded up to a power of two.
+     */
+    explicit SpscRing(std::size_t capacity)
+        : m_slots(std::bit_ceil(capacity < 2 ? std::size_t{2} : capacity)),
+          m_mask(m_slots.size() - 1) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    /**
+     * @brief Returns the number of slots.
+     */
+    inline std::size_t Capacity() const noexcept { return m_slots.size(); }
+
+    /**
+     * @brief Returns the free slot to be filled by the producer.
+     *
+     * The slot holds whatever was stored in it last. It becomes visible to the
+     * consumer after EndPush().
+     *
+     * @return Pointer to the slot, or nullptr if the ring is full.
+     */
+    T* BeginPush() noexcept {
+        const auto tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cachedHead == m_slots.size()) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead == m_slots.size()) {
+                return nullptr;
+            }
+        }
+        return &m_slots[tail & m_mask];
+    }
+
+    /**
+     * @brief Publishes the slot returned by the last BeginPush().
+     */
+    inline void EndPush() noexcept {
+        m_tail.store(m_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Pushes a value.
+     *
+     * @return False if the ring is full.
+     */
+    template <typename U>
+    bool TryPush(U&& value) {
+        auto* slot = BeginPush();
+        if (slot == nullptr) {
+            return false;
+        }
+        *slot = std::forward<U>(value);
+        EndPush();
+        return true;
+    }
+
+    /**
+     * @brief Returns the oldest published slot to the consumer.
+     *
+     * @return Pointer to the slot, or nullptr if the ring is empty.
+     */
+    T* Front() noexcept {
+        const auto head = m_head.load(std::memory_order_relaxed);
+        if (head == m_cachedTail) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cachedTail) {
+                return nullptr;
+            }
+        }
+        return &m_slots[head & m_mask];
+    }
+
+    /**
+     * @brief Releases the slot returned by Front() back to the producer.
+     */
+    inline void Pop() noexcept {
+        m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Pops the oldest value.
+     *
+     * @return False if the ring is empty.
+     */
+    bool TryPop(T& value) {
+        auto* slot = Front();
+        if (slot == nullptr) {
+            return false;
+        }
+        value = std::move(*slot);
+        Pop();
+        return true;
+    }
+
+    /**
+     * @brief Checks whether the ring is empty. Exact only on the consumer thread.
+     */
+    inline bool Empty() const noexcept {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+private:
+    std::vector<T> m_slots; /**< Ring slots. */
+    std::size_t m_mask;     /**< Index mask (capacity - 1). */
+
+    alignas(cacheLine) std::atomic<std::size_t> m_head{0}; /**< Next slot to pop. */
+    std::size_t m_cachedTail = 0;                          /**< Consumer's copy of m_tail. */
+
+    alignas(cacheLine) std::atomic<std::size_t> m_tail{0}; /**< Next slot to push. */
+    std::size_t m_cachedHead = 0;                          /**< Producer's copy of m_head. */
+};
+
+}  // namespace core::concurrency
@@ -25,6 +25,7 @@ enum ErrorCode : int32_t {
 
     // --- Serialization and data-related errors ---
     eInvalidJson,   /**< Invalid or malformed JSON data. */
+    eInvalidNumber, /**< Number does not fit the configured fixed-point scale. */
     eDataGap,       /**< Missing data detected (gap in sequence). */
     eDataDuplicate, /**< Duplicate data detected. */
 };
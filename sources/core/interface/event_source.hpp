@@ -0,0 +1,46 @@
+#pragma once
+
+#include <common/event/normalized_event.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace core::interface {
+
+/**
+ * @brief Normalized events parsed from one received frame.
+ */
+struct EventBatch {
+    std::vector<common::event::NormalizedEvent> events; /**< Events of the frame. */
+    uint64_t recvTsUs = 0;                              /**< Frame receive time in microseconds. */
+    std::size_t stream = 0;                             /**< Index of the stream in its source. */
+    bool resync = false;                                /**< First frame after a reconnect. */
+};
+
+/**
+ * @brief Consumer side of a queue of parsed event batches.
+ *
+ * A source hands out the batches of its streams in the order its parse stage
+ * produced them, without locks. Exactly one thread may consume a source.
+ */
+class IEventSource {
+public:
+    /**
+     * @brief Returns the oldest pending batch.
+     *
+     * @return Pointer to the batch, valid until Pop(), or nullptr if none is pending.
+     */
+    virtual const EventBatch* Front() noexcept = 0;
+
+    /**
+     * @brief Releases the batch returned by Front().
+     */
+    virtual void Pop() noexcept = 0;
+
+    /**
+     * @brief Virtual destructor for proper cleanup in derived classes.
+     */
+    virtual ~IEventSource() = default;
+};
+
+}  // namespace core::interface
@@ -8,6 +8,10 @@ namespace core::interface {
  * The IHandler interface defines a minimal contract for initialization
  * routines used by various system components, such as connectors,
  * processors, or data pipelines.
+ *
+ * Handlers that split their work into stages expose them via Parse() and
+ * Process(), which the engine pipeline polls from dedicated threads: one
+ * thread calls Parse() of every handler, another one calls Process().
  */
 class IHandler {
 public:
@@ -19,6 +23,34 @@ public:
      */
     virtual void Init() = 0;
 
+    /**
+     * @brief Runs one step of the parse stage (raw data to normalized events).
+     *
+     * Must not block. Called from the parse thread only.
+     *
+     * @return True if any work was done; otherwise false.
+     */
+    virtual bool Parse() { return false; }
+
+    /**
+     * @brief Runs one step of the processing stage (normalized events to strategy).
+     *
+     * Must not block. Called from the strategy thread only.
+     *
+     * @return True if any work was done; otherwise false.
+     */
+    virtual bool Process() { return false; }
+
+    /**
+     * @brief Runs one step of the processing stage once no more input will arrive.
+     *
+     * Called from the strategy thread after a stop, until it returns false, so that
+     * handlers holding work back for input that may still arrive release it.
+     *
+     * @return True if any work was done; otherwise false.
+     */
+    virtual bool Flush() { return Process(); }
+
     /**
      * @brief Virtual destructor for proper cleanup in derived classes.
      */
@@ -1,11 +1,22 @@
 #pragma once
 
 #include <core/error_handling/error_handling.hpp>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <span>
 
 namespace core::interface {
 
+/**
+ * @brief Number of readable bytes guaranteed past the end of every received span.
+ *
+ * Sessions hand frames to INotifier::OnReceiveSuccessed in place, so parsers that
+ * read past the end of the input (e.g. simdjson, which needs SIMDJSON_PADDING bytes)
+ * can consume them without copying.
+ */
+static constexpr std::size_t receivePadding = 64;
+
 /**
  * @brief Interface for event notification callbacks.
  *
@@ -30,9 +41,14 @@ public:
     /**
      * @brief Called when data is successfully received.
      *
+     * The span is followed by at least `receivePadding` readable bytes and is only
+     * valid for the duration of the call.
+     *
      * @param span A span containing the received raw byte data.
+     * @param recvTsNs Receive time in nanoseconds since the epoch, taken by the kernel
+     * where the session supports it.
      */
-    std::function<void(std::span<std::byte>)> OnReceiveSuccessed;
+    std::function<void(std::span<std::byte>, uint64_t)> OnReceiveSuccessed;
 
     /**
      * @brief Called when data reception fails.
@@ -3,7 +3,6 @@
 #include <common/event/normalized_event.hpp>
 #include <core/error_handling/error_handling.hpp>
 #include <cstdint>
-#include <functional>
 #include <span>
 #include <vector>
 
@@ -12,28 +11,36 @@ namespace core::interface {
 /**
  * @brief Interface for serializing and deserializing market events.
  *
- * The ISerializer interface provides asynchronous serialization support,
- * invoking callbacks on success or failure of deserialization.
+ * The ISerializer interface parses raw frames into normalized events written to a
+ * buffer owned by the caller. The caller reuses the buffer across frames, so once
+ * its capacity covers the largest frame no heap allocation is made per message.
  */
 class ISerializer {
 public:
-    /// Callback type invoked when deserialization succeeds.
-    using OnSuccess = std::function<void(const std::vector<common::event::NormalizedEvent>&)>;
-
-    /// Callback type invoked when deserialization fails.
-    using OnFail = std::function<void(core::error_handling::ErrorCode)>;
+    /// Caller-owned buffer the events of a frame are appended to.
+    using Events = std::vector<common::event::NormalizedEvent>;
 
     /**
      * @brief Deserializes raw data into normalized events.
      *
-     * Implementations must invoke the appropriate callback depending on
-     * whether deserialization succeeds or fails.
+     * The events are appended to `events`. On failure `events` is left as it was
+     * before the call.
      *
      * @param data The raw byte data to deserialize.
-     * @param successed Callback invoked with the deserialized events on success.
-     * @param failed Callback invoked with an error code on failure.
+     * @param recvTsNs Receive time of the data in nanoseconds since the epoch.
+     * @param events Buffer the deserialized events are appended to.
+     * @param ec Set to the reason of the failure.
+     * @return True on success, false otherwise.
+     */
+    virtual bool Serialize(std::span<std::byte> data, uint64_t recvTsNs, Events& events,
+                           core::error_handling::ErrorCode& ec) = 0;
+
+    /**
+     * @brief Forgets the stream state, e.g., after a reconnect.
+     *
+     * The next message is accepted regardless of its update ID.
      */
-    virtual void Serialize(std::span<std::byte> data, OnSuccess successed, OnFail failed) = 0;
+    virtual void Reset() { m_lastUpdateId = INVALID_UPDATE_ID; }
 
     /**
      * @brief Virtual destructor for proper cleanup in derived classes.
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <string>
 #include <string_view>
 
 #include "notifier.hpp"
@@ -31,6 +32,26 @@ public:
     virtual void Connect(std::string_view source, std::string_view target, uint16_t port,
                          INotifier* notifier) noexcept = 0;
 
+    /**
+     * @brief Sends a text message to the other side of the session.
+     *
+     * Messages are queued and written in order; messages sent before the connection
+     * is established are written right after it. May be called from any thread.
+     *
+     * @param message The message to send.
+     */
+    virtual void Send(std::string message) = 0;
+
+    /**
+     * @brief Changes the target used when the session reconnects.
+     *
+     * Lets subscription changes made on a live connection survive a reconnect.
+     * The current connection is not affected. Must be called on the session's io_context.
+     *
+     * @param target The new target.
+     */
+    virtual void SetTarget(std::string_view target) = 0;
+
     /**
      * @brief Virtual destructor for proper cleanup in derived classes.
      */
@@ -2,11 +2,208 @@
 
 #include <spdlog/sinks/stdout_color_sinks.h>
 
+#include <algorithm>
+#include <core/concurrency/spsc_byte_ring.hpp>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
 namespace core::log {
-void init_logger() {
+namespace {
+static constexpr std::size_t ringBytes = 1 << 20;              /**< Ring of a logging thread. */
+static constexpr auto idleSleep = std::chrono::milliseconds{1}; /**< Backend poll interval. */
+
+/**
+ * @brief Ring of a logging thread, shared with the backend so it outlives the thread.
+ */
+struct Producer {
+    concurrency::SpscByteRing ring{ringBytes}; /**< Records of the thread. */
+    std::atomic<uint64_t> dropped{0};          /**< Records that did not fit, not yet reported. */
+    std::atomic<bool> exited{false};           /**< The thread is gone. */
+};
+
+/**
+ * @brief Formats the records of all threads on a background thread.
+ */
+class Backend final {
+public:
+    static Backend& Instance() {
+        static Backend backend;
+        return backend;
+    }
+
+    ~Backend() { Stop(); }
+
+    std::shared_ptr<Producer> Register() {
+        auto producer = std::make_shared<Producer>();
+        std::lock_guard lock{m_mutex};
+        m_producers.push_back(producer);
+        return producer;
+    }
+
+    void Start() {
+        std::lock_guard lock{m_startMutex};
+        if (m_thread.joinable()) {
+            return;
+        }
+        m_thread = std::jthread{[this](std::stop_token stop) {
+            while (!stop.stop_requested()) {
+                if (!Drain()) {
+                    std::this_thread::sleep_for(idleSleep);
+                }
+            }
+        }};
+        detail::backendRunning.store(true, std::memory_order_release);
+    }
+
+    void Stop() {
+        std::lock_guard lock{m_startMutex};
+        if (!m_thread.joinable()) {
+            return;
+        }
+        detail::backendRunning.store(false, std::memory_order_release);
+        m_thread.request_stop();
+        m_thread.join();
+        // records committed before the flag was seen
+        Drain();
+        if (auto* logger = spdlog::default_logger_raw()) {
+            logger->flush();
+        }
+    }
+
+private:
+    /**
+     * @brief Formats the queued records of all threads in timestamp order.
+     *
+     * @return Whether any record was formatted.
+     */
+    bool Drain() {
+        std::vector<std::shared_ptr<Producer>> producers;
+        {
+            std::lock_guard lock{m_mutex};
+            producers = m_producers;
+        }
+
+        bool any = false;
+        for (;;) {
+            Producer* oldest = nullptr;
+            std::span<const std::byte> oldestRecord;
+            detail::Header oldestHeader{};
+            for (const auto& producer : producers) {
+                const auto record = producer->ring.Front();
+                if (record.empty()) {
+                    continue;
+                }
+                detail::Header header;
+                std::memcpy(&header, record.data(), sizeof(header));
+                if (oldest == nullptr || header.timeNs < oldestHeader.timeNs) {
+                    oldest = producer.get();
+                    oldestRecord = record;
+                    oldestHeader = header;
+                }
+            }
+            if (oldest == nullptr) {
+                break;
+            }
+
+            Emit(oldestHeader, oldestRecord.data() + sizeof(detail::Header));
+            oldest->ring.Pop();
+            any = true;
+        }
+
+        ReportDropped(producers);
+        RemoveExited();
+        return any;
+    }
+
+    void Emit(const detail::Header& header, const std::byte* args) {
+        auto* logger = spdlog::default_logger_raw();
+        if (logger == nullptr) {
+            return;
+        }
+
+        m_message.clear();
+        try {
+            header.decode(args, {header.format, header.formatSize}, m_message);
+        } catch (const std::exception& e) {
+            m_message.clear();
+            fmt::format_to(fmt::appender(m_message), "Failed to format log record: {}",
+                           e.what());
+        }
+        const spdlog::log_clock::time_point time{std::chrono::duration_cast<
+            spdlog::log_clock::duration>(std::chrono::nanoseconds{header.timeNs})};
+        logger->log(time, spdlog::source_loc{}, header.level,
+                    spdlog::string_view_t{m_message.data(), m_message.size()});
+    }
+
+    void ReportDropped(const std::vector<std::shared_ptr<Producer>>& producers) {
+        uint64_t dropped = 0;
+        for (const auto& producer : producers) {
+            dropped += producer->dropped.exchange(0, std::memory_order_relaxed);
+        }
+        if (dropped != 0) {
+            if (auto* logger = spdlog::default_logger_raw()) {
+                logger->warn("Dropped {} log records, the log ring of a thread was full",
+                             dropped);
+            }
+        }
+    }
+
+    void RemoveExited() {
+        std::lock_guard lock{m_mutex};
+        std::erase_if(m_producers, [](const auto& producer) {
+            return producer->exited.load(std::memory_order_acquire) &&
+                   producer->ring.Front().empty();
+        });
+    }
+
+private:
+    std::mutex m_mutex;                                 /**< Guards the producer list. */
+    std::vector<std::shared_ptr<Producer>> m_producers; /**< Rings of all logging threads. */
+    std::mutex m_startMutex;                            /**< Serializes Start and Stop. */
+    std::jthread m_thread;                              /**< Formatting thread. */
+    fmt::memory_buffer m_message;                       /**< Message being formatted. */
+};
+
+/**
+ * @brief Registers the ring of a thread on its first record and marks it on exit.
+ */
+struct ThreadProducer {
+    std::shared_ptr<Producer> producer = Backend::Instance().Register();
+
+    ~ThreadProducer() { producer->exited.store(true, std::memory_order_release); }
+};
+
+Producer& ThisProducer() {
+    static thread_local ThreadProducer thread;
+    return *thread.producer;
+}
+}  // namespace
+
+std::byte* detail::Reserve(std::size_t size) noexcept {
+    auto& producer = ThisProducer();
+    auto* record = producer.ring.Reserve(size);
+    if (record == nullptr) [[unlikely]] {
+        producer.dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    return record;
+}
+
+void detail::Commit() noexcept {
+    ThisProducer().ring.Commit();
+}
+
+void init_logger(spdlog::level::level_enum level) {
     auto console = spdlog::stdout_color_mt("console");
     console->set_pattern("[%H:%M:%S.%e] [%^%l%$] %v");
     spdlog::set_default_logger(console);
-    spdlog::set_level(spdlog::level::trace);
+    spdlog::set_level(level);
+    Backend::Instance().Start();
+}
+
+void shutdown_logger() {
+    Backend::Instance().Stop();
 }
 }  // namespace core::log
@@ -2,15 +2,44 @@
 
 #include <spdlog/spdlog.h>
 
-#define LOG(logLevel, formatString, ...)                                                     \
-    do {                                                                                     \
-        try {                                                                                \
-            if (spdlog::should_log(spdlog::level::logLevel)) [[unlikely]] {                  \
-                spdlog::log(spdlog::level::logLevel, "[" __FILE_NAME__ ":{}] " formatString, \
-                            __LINE__, ##__VA_ARGS__);                                        \
-            }                                                                                \
-        } catch (...) {                                                                      \
-        }                                                                                    \
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+/**
+ * @brief Lowest level compiled into LOG, one of the SPDLOG_LEVEL_* values.
+ *
+ * Statements below it are discarded at compile time and their arguments are never
+ * evaluated.
+ */
+#ifndef LOG_ACTIVE_LEVEL
+#define LOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#endif
+
+#define LOG_STRINGIFY_IMPL(value) #value
+#define LOG_STRINGIFY(value) LOG_STRINGIFY_IMPL(value)
+
+#define LOG(logLevel, formatString, ...)                                                    \
+    do {                                                                                    \
+        if constexpr (spdlog::level::logLevel >= LOG_ACTIVE_LEVEL) {                        \
+            try {                                                                           \
+                if (spdlog::should_log(spdlog::level::logLevel)) [[unlikely]] {             \
+                    core::log::Write(spdlog::level::logLevel,                               \
+                                     "[" __FILE_NAME__ ":" LOG_STRINGIFY(__LINE__) "] "     \
+                                     formatString, ##__VA_ARGS__);                          \
+                }                                                                           \
+            } catch (...) {                                                                 \
+            }                                                                               \
+        }                                                                                   \
     } while (false)
 
 #ifndef NDEBUG
@@ -20,5 +49,218 @@
 #endif
 
 namespace core::log {
-void init_logger();
+
+/**
+ * @brief Asynchronous logging.
+ *
+ * Once init_logger() has started the backend, LOG does not format on the calling thread.
+ * It copies a pointer to the format string, a timestamp and the raw bytes of the arguments
+ * into a lock-free ring owned by the calling thread (see SpscByteRing), and a background
+ * thread formats the records of all threads in timestamp order and passes them to spdlog.
+ *
+ * Arguments are captured by value when they are arithmetic, enums, strings (copied), or
+ * trivially copyable types that opt in with an ADL-visible declaration
+ *
+ *     std::true_type log_by_value(const T&);
+ *
+ * which promises that they hold no pointer to memory that may be gone when the record is
+ * formatted. A statement with any other argument is formatted on the calling thread and
+ * only the resulting text goes through the ring. A record that does not fit into the ring
+ * is dropped and counted rather than blocking the caller.
+ */
+
+/**
+ * @brief Starts the console logger and its background thread.
+ *
+ * @param level Initial runtime level, statements below it return after a relaxed load.
+ */
+void init_logger(spdlog::level::level_enum level = spdlog::level::info);
+
+/**
+ * @brief Formats all queued records and stops the background thread.
+ *
+ * Later statements are logged synchronously. Called automatically at exit.
+ */
+void shutdown_logger();
+
+namespace detail {
+
+/**
+ * @brief Argument types copied as text.
+ */
+template <typename T>
+concept StringLike = std::same_as<T, std::string> || std::same_as<T, std::string_view> ||
+                     std::same_as<T, const char*> || std::same_as<T, char*> ||
+                     (std::is_array_v<T> && std::same_as<std::remove_extent_t<T>, char>) ||
+                     (std::is_array_v<T> && std::same_as<std::remove_extent_t<T>, const char>);
+
+/**
+ * @brief Argument types copied as raw bytes.
+ */
+template <typename T>
+concept ByValue =
+    std::is_trivially_copyable_v<T> && alignof(T) <= 8 &&
+    (std::is_arithmetic_v<T> || std::is_enum_v<T> || requires(const T& value) {
+        { log_by_value(value) } -> std::same_as<std::true_type>;
+    });
+
+/**
+ * @brief Argument types that can be formatted on the background thread.
+ */
+template <typename T>
+concept Capturable = StringLike<T> || ByValue<T>;
+
+/**
+ * @brief Type an argument is formatted as after decoding.
+ */
+template <typename T>
+using Decoded = std::conditional_t<StringLike<T>, std::string_view, T>;
+
+/**
+ * @brief Formats the arguments of a record.
+ *
+ * @param args Encoded arguments.
+ * @param format Format string of the statement.
+ * @param out Buffer receiving the message.
+ */
+using Decoder = void (*)(const std::byte* args, std::string_view format,
+                         fmt::memory_buffer& out);
+
+/**
+ * @brief Fixed part of a record, followed by the encoded arguments.
+ */
+struct Header {
+    Decoder decode;                  /**< Formats the arguments. */
+    const char* format;              /**< Format string, a literal. */
+    uint32_t formatSize;             /**< Length of the format string. */
+    spdlog::level::level_enum level; /**< Level of the statement. */
+    int64_t timeNs;                  /**< Wall-clock time of the statement. */
+};
+
+inline std::atomic<bool> backendRunning{false}; /**< Records are consumed by the backend. */
+
+/**
+ * @brief Reserves a record in the ring of the calling thread.
+ *
+ * @return Pointer to the record, or nullptr if it was dropped.
+ */
+std::byte* Reserve(std::size_t size) noexcept;
+
+/**
+ * @brief Publishes the record returned by the last Reserve() of the calling thread.
+ */
+void Commit() noexcept;
+
+/**
+ * @brief Rounds a size up to the 8-byte alignment of encoded values.
+ */
+constexpr std::size_t Align(std::size_t size) noexcept {
+    return (size + 7) & ~std::size_t{7};
+}
+
+template <typename T>
+inline std::string_view AsString(const T& value) noexcept {
+    if constexpr (std::is_array_v<T>) {
+        return {value, std::char_traits<char>::length(value)};
+    } else {
+        return value;
+    }
+}
+
+template <typename T>
+inline std::size_t EncodedSize(const T& value) noexcept {
+    if constexpr (StringLike<T>) {
+        return sizeof(uint64_t) + Align(AsString(value).size());
+    } else {
+        return Align(sizeof(T));
+    }
+}
+
+template <typename T>
+inline std::byte* Encode(std::byte* out, const T& value) noexcept {
+    if constexpr (StringLike<T>) {
+        const auto text = AsString(value);
+        const uint64_t size = text.size();
+        std::memcpy(out, &size, sizeof(size));
+        std::memcpy(out + sizeof(size), text.data(), text.size());
+        return out + sizeof(size) + Align(text.size());
+    } else {
+        std::memcpy(out, &value, sizeof(T));
+        return out + Align(sizeof(T));
+    }
+}
+
+template <typename T>
+inline Decoded<T> DecodeOne(const std::byte*& in) noexcept {
+    if constexpr (StringLike<T>) {
+        uint64_t size;
+        std::memcpy(&size, in, sizeof(size));
+        const std::string_view text{reinterpret_cast<const char*>(in + sizeof(size)), size};
+        in += sizeof(size) + Align(size);
+        return text;
+    } else {
+        std::array<std::byte, sizeof(T)> bytes;
+        std::memcpy(bytes.data(), in, sizeof(T));
+        in += Align(sizeof(T));
+        return std::bit_cast<T>(bytes);
+    }
+}
+
+template <typename... Args>
+void Decode([[maybe_unused]] const std::byte* args, std::string_view format,
+            fmt::memory_buffer& out) {
+    // braced initialization decodes the arguments in order
+    std::tuple<Decoded<Args>...> values{DecodeOne<Args>(args)...};
+    std::apply(
+        [&](auto&... value) {
+            fmt::vformat_to(fmt::appender(out), format, fmt::make_format_args(value...));
+        },
+        values);
+}
+
+template <typename... Args>
+void Enqueue(spdlog::level::level_enum level, std::string_view format, const Args&... args) {
+    const auto size = sizeof(Header) + (std::size_t{0} + ... + EncodedSize(args));
+    auto* record = Reserve(size);
+    if (record == nullptr) {
+        return;
+    }
+
+    const Header header{&Decode<Args...>, format.data(), static_cast<uint32_t>(format.size()),
+                        level,
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::system_clock::now().time_since_epoch())
+                            .count()};
+    std::memcpy(record, &header, sizeof(header));
+    [[maybe_unused]] auto* out = record + sizeof(Header);
+    ((out = Encode(out, args)), ...);
+    Commit();
+}
+}  // namespace detail
+
+/**
+ * @brief Logs a statement, see LOG.
+ *
+ * @param level Level of the statement.
+ * @param format Format string, must be a literal since it is formatted later.
+ * @param args Arguments of the format string.
+ */
+template <typename... Args>
+void Write(spdlog::level::level_enum level, fmt::format_string<Args...> format, Args&&... args) {
+    if (!detail::backendRunning.load(std::memory_order_relaxed)) [[unlikely]] {
+        spdlog::log(level, format, std::forward<Args>(args)...);
+        return;
+    }
+
+    const fmt::string_view view = format;
+    const std::string_view text{view.data(), view.size()};
+    if constexpr ((detail::Capturable<std::remove_cvref_t<Args>> && ...)) {
+        detail::Enqueue<std::remove_cvref_t<Args>...>(level, text, args...);
+    } else {
+        fmt::memory_buffer message;
+        fmt::vformat_to(fmt::appender(message), text, fmt::make_format_args(args...));
+        detail::Enqueue<std::string_view>(level, "{}",
+                                          std::string_view{message.data(), message.size()});
+    }
+}
 }  // namespace core::log
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace core::metrics {
+
+/**
+ * @brief Returns the wall-clock time in nanoseconds since the epoch.
+ *
+ * The clock of the receive timestamps, comparable with kernel receive times.
+ */
+inline uint64_t NowNs() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+/**
+ * @brief Returns the wall-clock time in microseconds since the epoch.
+ *
+ * The clock of the NormalizedEvent timestamps, comparable with exchange times.
+ */
+inline uint64_t NowUs() noexcept {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+}  // namespace core::metrics
@@ -0,0 +1,55 @@
+#include "histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace core::metrics {
+
+static_assert(Histogram::Index((1ULL << Histogram::maxBits) - 1) == Histogram::bucketCount - 1);
+static_assert(Histogram::UpperBound(Histogram::Index(1000)) >= 1000);
+
+void HistogramSnapshot::Add(const Histogram& histogram) noexcept {
+    for (std::size_t i = 0; i < m_counts.size(); ++i) {
+        m_counts[i] += histogram.Count(i);
+    }
+}
+
+void HistogramSnapshot::Subtract(const HistogramSnapshot& earlier) noexcept {
+    for (std::size_t i = 0; i < m_counts.size(); ++i) {
+        m_counts[i] -= earlier.m_counts[i];
+    }
+}
+
+uint64_t HistogramSnapshot::TotalCount() const noexcept {
+    return std::accumulate(m_counts.begin(), m_counts.end(), uint64_t{0});
+}
+
+uint64_t HistogramSnapshot::ValueAt(double percentile) const noexcept {
+    const auto total = TotalCount();
+    if (total == 0) {
+        return 0;
+    }
+
+    // rank of the value, 1-based, so that p100 is the last value and p0 the first
+    const auto rank = std::max<uint64_t>(
+        1, static_cast<uint64_t>(std::ceil(percentile / 100 * static_cast<double>(total))));
+    uint64_t seen = 0;
+    for (std::size_t i = 0; i < m_counts.size(); ++i) {
+        seen += m_counts[i];
+        if (seen >= rank) {
+            return Histogram::UpperBound(i);
+        }
+    }
+    return Histogram::UpperBound(m_counts.size() - 1);
+}
+
+uint64_t HistogramSnapshot::Max() const noexcept {
+    for (auto i = m_counts.size(); i-- > 0;) {
+        if (m_counts[i] != 0) {
+            return Histogram::UpperBound(i);
+        }
+    }
+    return 0;
+}
+}  // namespace core::metrics
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace core::metrics {
+
+/**
+ * @brief Log-linear latency histogram in the spirit of HdrHistogram.
+ *
+ * Values below 128 get a bucket each; above that every power of two is split
+ * into 64 equal buckets, so any recorded value is known within 1/64 (~1.6%) of
+ * itself. Values up to 2^36 (~68 s in nanoseconds) are tracked, larger ones are
+ * clamped into the last bucket.
+ *
+ * Recording is a handful of instructions and never allocates. Counters are
+ * relaxed atomics written by a single owner thread without read-modify-write
+ * instructions, so another thread may read (merge) them at any time and sees
+ * every count at most slightly late.
+ */
+class Histogram final {
+public:
+    static constexpr unsigned subBucketBits = 7;                  /**< Exact range bits. */
+    static constexpr uint64_t subBuckets = 1ULL << subBucketBits; /**< Buckets of exact range. */
+    static constexpr uint64_t halfBuckets = subBuckets / 2;       /**< Buckets per power of 2. */
+    static constexpr unsigned maxBits = 36;                       /**< Bits of the largest value. */
+    static constexpr std::size_t bucketCount =
+        halfBuckets * (maxBits - subBucketBits) + subBuckets; /**< Number of buckets. */
+
+    /**
+     * @brief Returns the bucket of a value.
+     */
+    static constexpr std::size_t Index(uint64_t value) noexcept {
+        if (value < subBuckets) {
+            return static_cast<std::size_t>(value);
+        }
+        if (value >= (1ULL << maxBits)) {
+            return bucketCount - 1;
+        }
+        const auto shift = static_cast<unsigned>(std::bit_width(value)) - subBucketBits;
+        return static_cast<std::size_t>(halfBuckets * shift + (value >> shift));
+    }
+
+    /**
+     * @brief Returns the largest value that falls into a bucket.
+     */
+    static constexpr uint64_t UpperBound(std::size_t index) noexcept {
+        if (index < subBuckets) {
+            return index;
+        }
+        const auto shift = static_cast<unsigned>(index / halfBuckets - 1);
+        const auto mantissa = index - halfBuckets * shift;
+        return ((mantissa + 1) << shift) - 1;
+    }
+
+    /**
+     * @brief Records a value. Must only be called by the owner thread.
+     *
+     * @param value Value to record, e.g. nanoseconds.
+     */
+    inline void Record(uint64_t value) noexcept {
+        auto& count = m_counts[Index(value)];
+        count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns the count of a bucket. May be called from any thread.
+     */
+    inline uint64_t Count(std::size_t index) const noexcept {
+        return m_counts[index].load(std::memory_order_relaxed);
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, bucketCount> m_counts{}; /**< Count per bucket. */
+};
+
+/**
+ * @brief Plain copy of histogram counts used to merge, diff and query histograms.
+ */
+class HistogramSnapshot final {
+public:
+    /**
+     * @brief Adds the current counts of a histogram.
+     */
+    void Add(const Histogram& histogram) noexcept;
+
+    /**
+     * @brief Subtracts an earlier snapshot, leaving the counts recorded since.
+     */
+    void Subtract(const HistogramSnapshot& earlier) noexcept;
+
+    /**
+     * @brief Returns the number of recorded values.
+     */
+    uint64_t TotalCount() const noexcept;
+
+    /**
+     * @brief Returns the value at a percentile, with the precision of a bucket.
+     *
+     * @param percentile Percentile in [0, 100].
+     * @return The upper bound of the bucket holding the percentile, 0 if empty.
+     */
+    uint64_t ValueAt(double percentile) const noexcept;
+
+    /**
+     * @brief Returns the largest recorded value, with the precision of a bucket.
+     */
+    uint64_t Max() const noexcept;
+
+private:
+    std::array<uint64_t, Histogram::bucketCount> m_counts{}; /**< Count per bucket. */
+};
+
+}  // namespace core::metrics
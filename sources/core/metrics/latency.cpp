@@ -0,0 +1,102 @@
+#include "latency.hpp"
+
+#include <array>
+#include <condition_variable>
+#include <core/log/log.hpp>
+#include <magic_enum/magic_enum.hpp>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "histogram.hpp"
+
+namespace core::metrics {
+namespace {
+using Histograms = std::array<Histogram, stageCount>;         /**< Histograms of a thread. */
+using Snapshots = std::array<HistogramSnapshot, stageCount>; /**< Merged counts per stage. */
+
+/**
+ * @brief Owns the histograms of every thread that recorded so far.
+ */
+class Registry final {
+public:
+    static Registry& Instance() {
+        static Registry registry;
+        return registry;
+    }
+
+    Histograms& Register() {
+        std::lock_guard lock{m_mutex};
+        return *m_threads.emplace_back(std::make_unique<Histograms>());
+    }
+
+    /**
+     * @brief Merges all threads and returns the counts recorded since the last call.
+     */
+    std::unique_ptr<Snapshots> Interval() {
+        auto current = std::make_unique<Snapshots>();
+        {
+            std::lock_guard lock{m_mutex};
+            for (const auto& histograms : m_threads) {
+                for (std::size_t i = 0; i < stageCount; ++i) {
+                    (*current)[i].Add((*histograms)[i]);
+                }
+            }
+        }
+
+        auto interval = std::make_unique<Snapshots>(*current);
+        for (std::size_t i = 0; i < stageCount; ++i) {
+            (*interval)[i].Subtract(m_last[i]);
+        }
+        m_last = *current;
+        return interval;
+    }
+
+private:
+    std::mutex m_mutex;                                 /**< Guards the thread list. */
+    std::vector<std::unique_ptr<Histograms>> m_threads; /**< Histograms of every thread. */
+    Snapshots m_last;                                   /**< Totals at the last report. */
+};
+}  // namespace
+
+void detail::Record(Stage stage, uint64_t ns) noexcept {
+    // histograms outlive their thread, a late report still sees its counts
+    static thread_local Histograms* histograms = &Registry::Instance().Register();
+    (*histograms)[static_cast<std::size_t>(stage)].Record(ns);
+}
+
+void ReportLatency() {
+    static std::mutex reportMutex;
+    std::lock_guard lock{reportMutex};
+
+    const auto interval = Registry::Instance().Interval();
+    for (std::size_t i = 0; i < stageCount; ++i) {
+        const auto& stage = (*interval)[i];
+        const auto count = stage.TotalCount();
+        if (count == 0) {
+            continue;
+        }
+        LOG(info, "Latency {:<10} n={} p50={}ns p99={}ns p99.9={}ns max={}ns",
+            magic_enum::enum_name(static_cast<Stage>(i)), count, stage.ValueAt(50),
+            stage.ValueAt(99), stage.ValueAt(99.9), stage.Max());
+    }
+}
+
+LatencyReporter::LatencyReporter(std::chrono::milliseconds period) {
+    EnableLatency(true);
+    m_thread = std::jthread{[period](std::stop_token stop) {
+        std::mutex mutex;
+        std::condition_variable_any wakeup;
+        std::unique_lock lock{mutex};
+        while (!wakeup.wait_for(lock, stop, period, [&stop] { return stop.stop_requested(); })) {
+            ReportLatency();
+        }
+    }};
+}
+
+LatencyReporter::~LatencyReporter() {
+    m_thread.request_stop();
+    m_thread.join();
+    ReportLatency();
+}
+}  // namespace core::metrics
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+namespace core::metrics {
+
+/**
+ * @brief Stage latency recording.
+ *
+ * Every thread records into its own set of histograms (see Histogram), created on
+ * its first record and kept for the lifetime of the process, so recording takes no
+ * locks and shares no cache lines. ReportLatency() merges the histograms of all
+ * threads and logs the percentiles of what was recorded since the previous report.
+ *
+ * Recording is off until EnableLatency(true); a disabled probe costs a relaxed load
+ * and a branch.
+ */
+
+/**
+ * @brief Instrumented stages of the receive → SOR path.
+ */
+enum class Stage {
+    Receive,    /**< Socket receive (kernel timestamp) until the frame is handed over. */
+    Serialize,  /**< Parsing a frame into normalized events (ISerializer::Serialize). */
+    Vwap,       /**< VWAP::Compute. */
+    Regression, /**< AlmgrenChrissTracker::ComputeRegression. */
+    Sor,        /**< SOR::Compute. */
+};
+
+/**
+ * @brief Number of instrumented stages.
+ */
+static constexpr std::size_t stageCount = static_cast<std::size_t>(Stage::Sor) + 1;
+
+namespace detail {
+inline std::atomic<bool> latencyEnabled{false}; /**< Whether probes record. */
+
+/**
+ * @brief Records a value into the histogram of the calling thread.
+ */
+void Record(Stage stage, uint64_t ns) noexcept;
+}  // namespace detail
+
+/**
+ * @brief Turns latency recording on or off.
+ */
+inline void EnableLatency(bool enabled) noexcept {
+    detail::latencyEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Checks whether latency recording is on.
+ */
+inline bool LatencyEnabled() noexcept {
+    return detail::latencyEnabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Records the latency of a stage if recording is on.
+ *
+ * @param stage Stage the latency belongs to.
+ * @param ns Latency in nanoseconds.
+ */
+inline void RecordLatency(Stage stage, uint64_t ns) noexcept {
+    if (LatencyEnabled()) [[unlikely]] {
+        detail::Record(stage, ns);
+    }
+}
+
+/**
+ * @brief Logs p50/p99/p99.9/max of every stage recorded since the previous report.
+ */
+void ReportLatency();
+
+/**
+ * @brief Records the time from construction to destruction as a stage latency.
+ */
+class ScopedLatency final {
+public:
+    using clock_t = std::chrono::steady_clock; /**< Clock of the measurement. */
+
+    explicit ScopedLatency(Stage stage) noexcept
+        : m_stage(stage),
+          m_enabled(LatencyEnabled()),
+          m_start(m_enabled ? clock_t::now() : clock_t::time_point{}) {}
+
+    ~ScopedLatency() {
+        if (m_enabled) [[unlikely]] {
+            const auto elapsed = clock_t::now() - m_start;
+            detail::Record(m_stage,
+                           std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        }
+    }
+
+    ScopedLatency(const ScopedLatency&) = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+
+private:
+    Stage m_stage;               /**< Stage being measured. */
+    bool m_enabled;              /**< Recording was on at construction. */
+    clock_t::time_point m_start; /**< Start of the measurement. */
+};
+
+/**
+ * @brief Background thread calling ReportLatency() periodically.
+ *
+ * Enables latency recording for its lifetime and reports once more on destruction.
+ */
+class LatencyReporter final {
+public:
+    /**
+     * @brief Starts reporting.
+     *
+     * @param period Interval between reports.
+     */
+    explicit LatencyReporter(std::chrono::milliseconds period);
+
+    ~LatencyReporter();
+
+    LatencyReporter(const LatencyReporter&) = delete;
+    LatencyReporter& operator=(const LatencyReporter&) = delete;
+
+private:
+    std::jthread m_thread; /**< Reporting thread. */
+};
+
+}  // namespace core::metrics
@@ -0,0 +1,103 @@
+#include "event_bus.hpp"
+
+#include <algorithm>
+#include <core/log/log.hpp>
+#include <core/metrics/clock.hpp>
+#include <stdexcept>
+
+namespace engine {
+
+using core::metrics::NowUs;
+
+std::size_t EventBus::AddSymbol(const StrategyConfig& config) {
+    m_symbols.emplace_back(config);
+    return m_symbols.size() - 1;
+}
+
+void EventBus::AddSource(std::size_t symbol, core::interface::IEventSource& source) {
+    if (symbol >= m_symbols.size()) {
+        throw std::out_of_range{"Unknown symbol of an event source"};
+    }
+    m_symbols[symbol].sources.push_back(&source);
+}
+
+void EventBus::Init() {
+    for (const auto& symbol : m_symbols) {
+        LOG(info, "Event bus routes {} sources to strategy {}. Reorder window: {} us",
+            symbol.sources.size(), symbol.strategy.Symbol(), m_options.reorderWindow.count());
+    }
+}
+
+bool EventBus::Process() {
+    bool processed = false;
+    uint64_t nowUs = 0;
+    const bool wait = m_options.reorderWindow.count() != 0;
+    for (auto& symbol : m_symbols) {
+        processed |= Step(symbol, nowUs, wait);
+    }
+    return processed;
+}
+
+bool EventBus::Flush() {
+    bool processed = false;
+    uint64_t nowUs = 0;
+    for (auto& symbol : m_symbols) {
+        processed |= Step(symbol, nowUs, false);
+    }
+    return processed;
+}
+
+uint64_t EventBus::Late() const noexcept {
+    uint64_t late = 0;
+    for (const auto& symbol : m_symbols) {
+        late += symbol.late;
+    }
+    return late;
+}
+
+bool EventBus::Step(Symbol& symbol, uint64_t& nowUs, bool wait) {
+    core::interface::IEventSource* oldest = nullptr;
+    const core::interface::EventBatch* batch = nullptr;
+    bool complete = true;
+    for (auto* source : symbol.sources) {
+        const auto* front = source->Front();
+        if (front == nullptr) {
+            complete = false;
+        } else if (batch == nullptr || front->recvTsUs < batch->recvTsUs) {
+            oldest = source;
+            batch = front;
+        }
+    }
+    if (batch == nullptr) {
+        return false;
+    }
+
+    // an idle source may still deliver an older batch, wait for it up to the window
+    if (wait && !complete) {
+        if (nowUs == 0) {
+            nowUs = NowUs();
+        }
+        const auto window = static_cast<uint64_t>(m_options.reorderWindow.count());
+        if (batch->recvTsUs + window > nowUs) {
+            return false;
+        }
+    }
+
+    if (batch->recvTsUs < symbol.lastTsUs) [[unlikely]] {
+        ++symbol.late;
+        LOG(debug, "[{}] batch of stream {} is {} us late", symbol.strategy.Symbol(),
+            batch->stream, symbol.lastTsUs - batch->recvTsUs);
+    }
+    symbol.lastTsUs = std::max(symbol.lastTsUs, batch->recvTsUs);
+
+    if (batch->resync) [[unlikely]] {
+        symbol.strategy.OnResync();
+    }
+    if (!batch->events.empty()) {
+        symbol.strategy.OnEvents(batch->events);
+    }
+    oldest->Pop();
+    return true;
+}
+
+}  // namespace engine
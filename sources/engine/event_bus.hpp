@@ -0,0 +1,135 @@
+#pragma once
+
+#include <chrono>
+#include <core/interface/event_source.hpp>
+#include <core/interface/handler.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "strategy.hpp"
+
+namespace engine {
+
+/**
+ * @brief Routes normalized events of any number of streams to per-symbol strategies.
+ *
+ * Handlers parse their streams and queue the events of every frame as a batch
+ * (see core::interface::IEventSource). The bus is a handler whose Process() stage
+ * runs on the strategy thread: it consumes the sources of every symbol and applies
+ * their batches to the one Strategy of the symbol, so that depth and trade streams,
+ * even of different handlers and connections, feed the same book and impact model.
+ *
+ * Batches of a symbol are merged in receive time order. The oldest pending batch
+ * is applied right away if every source of the symbol has a batch pending, since
+ * nothing older can arrive then. Otherwise an idle source may still deliver an
+ * older batch. By default the oldest one is applied anyway, so an idle stream
+ * never delays the others; with a reorder window it waits until it is older than
+ * the window. A batch that arrives after a newer one was applied is applied
+ * anyway and counted as late. Flush() applies held batches without waiting.
+ *
+ * Sources are single-producer/single-consumer rings, the bus adds no locks.
+ * Symbols and sources must be added before the pipeline starts.
+ */
+class EventBus final : public core::interface::IHandler {
+public:
+    /**
+     * @brief Merge settings of the bus.
+     */
+    struct Options {
+        std::chrono::microseconds reorderWindow{0}; /**< Wait for older batches, 0 = none. */
+    };
+
+    /**
+     * @brief Constructs a bus with the default reorder window.
+     */
+    EventBus() : EventBus(Options{}) {}
+
+    /**
+     * @brief Constructs a bus.
+     *
+     * @param options Merge settings.
+     */
+    explicit EventBus(const Options& options) : m_options(options) {}
+
+    /**
+     * @brief Adds a symbol with its strategy.
+     *
+     * @param config Strategy configuration of the symbol.
+     * @return Index of the symbol, used by AddSource().
+     * @throws std::invalid_argument if the strategy configuration is invalid.
+     */
+    std::size_t AddSymbol(const StrategyConfig& config);
+
+    /**
+     * @brief Adds a source of events of a symbol.
+     *
+     * The bus becomes the only consumer of the source, which must outlive the bus
+     * or at least the strategy thread.
+     *
+     * @param symbol Index of the symbol returned by AddSymbol().
+     * @param source Source of the events.
+     */
+    void AddSource(std::size_t symbol, core::interface::IEventSource& source);
+
+    /**
+     * @brief Logs the routing. Overrides IHandler::Init().
+     */
+    void Init() override;
+
+    /**
+     * @brief Applies at most one batch of every symbol.
+     *
+     * Overrides IHandler::Process(). Called from the strategy thread.
+     *
+     * @return True if any batch was applied; otherwise false.
+     */
+    bool Process() override;
+
+    /**
+     * @brief Applies at most one batch of every symbol without waiting for older ones.
+     *
+     * Overrides IHandler::Flush(). Called from the strategy thread once the sources
+     * are stopped.
+     *
+     * @return True if any batch was applied; otherwise false.
+     */
+    bool Flush() override;
+
+    /**
+     * @brief Returns the number of batches applied after a newer one of their symbol.
+     *
+     * Exact only on the strategy thread.
+     */
+    uint64_t Late() const noexcept;
+
+private:
+    /**
+     * @brief A symbol with its strategy and event sources.
+     */
+    struct Symbol {
+        explicit Symbol(const StrategyConfig& config) : strategy(config) {}
+
+        Strategy strategy;                                   /**< Strategy of the symbol. */
+        std::vector<core::interface::IEventSource*> sources; /**< Sources of its events. */
+        uint64_t lastTsUs = 0;                               /**< Receive time of the newest. */
+        uint64_t late = 0;                                   /**< Batches applied out of order. */
+    };
+
+    /**
+     * @brief Applies the oldest batch of a symbol if it is due.
+     *
+     * @param symbol The symbol.
+     * @param nowUs Current time in microseconds, taken on first use.
+     * @param wait Whether a batch waits for older ones within the reorder window.
+     * @return True if a batch was applied; otherwise false.
+     */
+    bool Step(Symbol& symbol, uint64_t& nowUs, bool wait);
+
+private:
+    Options m_options;            /**< Merge settings. */
+    std::deque<Symbol> m_symbols; /**< Symbols, their indexes are stable. */
+};
+
+}  // namespace engine
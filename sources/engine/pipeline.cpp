@@ -1,11 +1,155 @@
 #include "pipeline.hpp"
 
+#include <pthread.h>
+#include <sched.h>
+
 #include <core/log/log.hpp>
+#include <exception>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
 
 namespace engine {
+namespace {
+/**
+ * @brief Empty polls a stage spins before yielding its core.
+ */
+constexpr int idleSpins = 64;
+
+/**
+ * @brief Pins a thread to a CPU. Failures are logged, the thread keeps running unpinned.
+ */
+void SetAffinity(std::thread::native_handle_type thread, int cpu, std::string_view name) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (const auto rc = pthread_setaffinity_np(thread, sizeof(set), &set); rc != 0) {
+        LOG(warn, "Failed to pin {} thread to CPU {}. Error: {}", name, cpu, rc);
+        return;
+    }
+    LOG(info, "Pinned {} thread to CPU {}", name, cpu);
+}
+}  // namespace
+
+Pipeline::Pipeline(const Options& options) : m_options(options) {
+    if (m_options.ioThreads == 0) {
+        throw std::invalid_argument{"Pipeline needs at least one io thread"};
+    }
+    if (m_options.ioCpus.size() > m_options.ioThreads) {
+        throw std::invalid_argument{"More io CPUs than io threads are given"};
+    }
+
+    m_contexts.reserve(m_options.ioThreads);
+    for (std::size_t i = 0; i < m_options.ioThreads; ++i) {
+        // every io_context is run by a single thread
+        m_contexts.push_back(std::make_unique<boost::asio::io_context>(1));
+    }
+}
+
+Pipeline::~Pipeline() {
+    Stop();
+}
+
+boost::asio::io_context& Pipeline::NextContext() noexcept {
+    auto& ioc = *m_contexts[m_nextContext];
+    m_nextContext = (m_nextContext + 1) % m_contexts.size();
+    return ioc;
+}
+
 void Pipeline::Init() {
     for (auto& handler : m_handlers) {
         handler->Init();
     }
 }
-}  // namespace engine
\ No newline at end of file
+
+void Pipeline::Start() {
+    using core::interface::IHandler;
+
+    m_stages.emplace_back(
+        [this](std::stop_token token) { RunStage(token, &IHandler::Parse, &IHandler::Parse); });
+    if (m_options.parseCpu) {
+        SetAffinity(m_stages.back().native_handle(), *m_options.parseCpu, "parse");
+    }
+
+    m_stages.emplace_back(
+        [this](std::stop_token token) { RunStage(token, &IHandler::Process, &IHandler::Flush); });
+    if (m_options.strategyCpu) {
+        SetAffinity(m_stages.back().native_handle(), *m_options.strategyCpu, "strategy");
+    }
+
+    LOG(info, "Started pipeline with {} handlers", m_handlers.size());
+}
+
+void Pipeline::Run() {
+    std::vector<std::exception_ptr> errors(m_contexts.size());
+
+    // an exception on any network thread stops the whole pool and is rethrown here
+    const auto run = [this, &errors](std::size_t idx) {
+        try {
+            m_contexts[idx]->run();
+        } catch (...) {
+            errors[idx] = std::current_exception();
+            for (auto& ioc : m_contexts) {
+                ioc->stop();
+            }
+        }
+    };
+
+    {
+        std::vector<std::jthread> threads;
+        threads.reserve(m_contexts.size() - 1);
+        for (std::size_t i = 1; i < m_contexts.size(); ++i) {
+            threads.emplace_back(run, i);
+            if (i < m_options.ioCpus.size()) {
+                SetAffinity(threads.back().native_handle(), m_options.ioCpus[i], "io");
+            }
+        }
+
+        if (!m_options.ioCpus.empty()) {
+            SetAffinity(pthread_self(), m_options.ioCpus.front(), "io");
+        }
+        run(0);
+    }
+
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+void Pipeline::Stop() {
+    // stages are stopped in order, so the strategy drains everything the parser produced
+    for (auto& stage : m_stages) {
+        stage.request_stop();
+        stage.join();
+    }
+    m_stages.clear();
+}
+
+void Pipeline::RunStage(std::stop_token token, bool (core::interface::IHandler::*stage)(),
+                        bool (core::interface::IHandler::*drain)()) {
+    int idle = 0;
+    while (true) {
+        bool busy = false;
+        for (auto& handler : m_handlers) {
+            busy |= (handler.get()->*stage)();
+        }
+
+        if (busy) {
+            idle = 0;
+        } else if (token.stop_requested()) {
+            break;
+        } else if (++idle >= idleSpins) {
+            std::this_thread::yield();
+        }
+    }
+
+    for (bool busy = true; busy;) {
+        busy = false;
+        for (auto& handler : m_handlers) {
+            busy |= (handler.get()->*drain)();
+        }
+    }
+}
+}  // namespace engine
@@ -1,26 +1,77 @@
 #pragma once
 
+#include <boost/asio/io_context.hpp>
 #include <core/interface/handler.hpp>
+#include <cstddef>
 #include <memory>
+#include <optional>
+#include <stop_token>
+#include <thread>
 #include <vector>
 
 namespace engine {
 
 /**
- * @brief Pipeline for managing and initializing a sequence of handlers.
+ * @brief Pipeline for managing and running a sequence of handlers.
  *
  * The Pipeline class maintains a collection of IHandler objects, allowing
  * dynamic addition of handlers and providing a single entry point to
  * initialize all registered handlers in order.
+ *
+ * The pipeline owns a pool of io_contexts, each run by its own network thread.
+ * Handlers are spread over the pool with NextContext(), so a busy stream only
+ * delays the streams that share its thread. Once started, the pipeline also runs
+ * the stages of all handlers on dedicated threads: network threads only hand raw
+ * frames over, a parse thread polls IHandler::Parse() and a strategy thread polls
+ * IHandler::Process(). Stages are connected by lock-free rings owned by the
+ * handlers, so a slow stage never delays socket reads. Every thread can be pinned
+ * to a CPU.
  */
 class Pipeline final {
 public:
     using Handler = std::unique_ptr<core::interface::IHandler>; /**< Alias for a handler pointer. */
 
+    /**
+     * @brief Thread layout of the pipeline.
+     */
+    struct Options {
+        std::size_t ioThreads = 1;      /**< Number of io_contexts, one thread each. */
+        std::vector<int> ioCpus;        /**< CPU of every network thread, in pool order. */
+        std::optional<int> parseCpu;    /**< CPU of the parse thread. */
+        std::optional<int> strategyCpu; /**< CPU of the strategy thread. */
+    };
+
+    /**
+     * @brief Constructs a pipeline with a single network thread and no CPU pinning.
+     */
+    Pipeline() : Pipeline(Options{}) {}
+
+    /**
+     * @brief Constructs a pipeline.
+     *
+     * @param options Thread layout of the pipeline.
+     * @throws std::invalid_argument if the pool is empty or more CPUs than threads are given.
+     */
+    explicit Pipeline(const Options& options);
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    /**
+     * @brief Stops the stage threads.
+     */
+    ~Pipeline();
+
+    /**
+     * @brief Returns the io_context for the next handler, assigned round-robin.
+     */
+    boost::asio::io_context& NextContext() noexcept;
+
     /**
      * @brief Adds a new handler to the pipeline.
      *
-     * Ownership of the handler is transferred to the pipeline.
+     * Ownership of the handler is transferred to the pipeline. Handlers must be
+     * added before Start().
      *
      * @param handler The handler to add.
      */
@@ -33,8 +84,45 @@ public:
      */
     void Init();
 
+    /**
+     * @brief Starts the parse and strategy threads.
+     */
+    void Start();
+
+    /**
+     * @brief Runs the network threads until all io_contexts run out of work.
+     *
+     * The calling thread runs the first io_context itself. If a handler throws on any
+     * network thread, the whole pool is stopped and the exception is rethrown here.
+     */
+    void Run();
+
+    /**
+     * @brief Stops the stage threads after they have drained all pending work.
+     *
+     * The strategy thread ends with IHandler::Flush(), so nothing held back is lost.
+     */
+    void Stop();
+
+private:
+    /**
+     * @brief Polls one stage of every handler until a stop is requested and no work is left.
+     *
+     * @param token Stop token of the stage thread.
+     * @param stage Stage to poll (IHandler::Parse or IHandler::Process).
+     * @param drain Step polled after the stop until no work is left.
+     */
+    void RunStage(std::stop_token token, bool (core::interface::IHandler::*stage)(),
+                  bool (core::interface::IHandler::*drain)());
+
 private:
-    std::vector<Handler> m_handlers; /**< Collection of pipeline handlers. */
+    using context_t = std::unique_ptr<boost::asio::io_context>; /**< io_context pointer type. */
+
+    Options m_options;                  /**< Thread layout of the pipeline. */
+    std::vector<context_t> m_contexts;  /**< io_context pool, one per network thread. */
+    std::size_t m_nextContext = 0;      /**< Pool index of the next assigned io_context. */
+    std::vector<Handler> m_handlers;    /**< Collection of pipeline handlers. */
+    std::vector<std::jthread> m_stages; /**< Parse and strategy threads. */
 };
 
 }  // namespace engine
@@ -0,0 +1,97 @@
+#include "strategy.hpp"
+
+#include <core/log/log.hpp>
+#include <core/metrics/clock.hpp>
+#include <stdexcept>
+
+namespace engine {
+
+using core::metrics::NowUs;
+
+Strategy::Strategy(const StrategyConfig& config)
+    : m_symbol(config.symbol),
+      m_venue(config.venue),
+      m_takerFee(config.params.takerFee),
+      m_vwap(config.symbol, config.vwapBands),
+      m_sorBand(config.sorBand),
+      m_acTracker(config.symbol, config.ac),
+      m_sorLastUpdate(std::chrono::steady_clock::now()),
+      m_sor(config.params.lambda, config.params.targetAmount) {
+    if (m_sorBand >= m_vwap.GetBands().size()) {
+        throw std::invalid_argument{"SOR band index is out of the VWAP bands range"};
+    }
+}
+
+void Strategy::OnResync() {
+    LOG(warn, "[{}] stream reconnected, dropping the book and the Almgren–Chriss state",
+        m_symbol.name);
+    m_book.Clear();
+    m_acTracker.Reset();
+    m_venueEvents.clear();
+}
+
+void Strategy::OnEvents(std::span<const common::event::NormalizedEvent> events) {
+    core::algorithm::VenueData venueData;
+    venueData.name = m_venue;
+    float vwapBid;
+    float vwapAsk;
+
+    bool bookUpdated = false;
+    for (const auto& ne : events) {
+        LOG(trace, "[{}] got new normalized event: {}", m_symbol.name, ne);
+
+        if (ne.source == common::event::Source::Depth) {
+            m_book.Apply(ne);
+            bookUpdated = true;
+        } else {
+            m_acTracker.AddEvent(ne);
+        }
+    }
+    if (bookUpdated) {
+        m_acTracker.UpdateBook(m_book);
+    }
+
+    const auto& last = events.back();
+    // partial depth snapshots carry no exchange time, so there is no exchange->recv term
+    if (last.exchangeTsUs != 0) {
+        LOG(trace, "[{}] latency us: exchange->recv={} recv->parse={} parse->decision={}",
+            m_symbol.name, static_cast<int64_t>(last.recvTsUs - last.exchangeTsUs),
+            static_cast<int64_t>(last.tsUs - last.recvTsUs),
+            static_cast<int64_t>(NowUs() - last.tsUs));
+    } else {
+        LOG(trace, "[{}] latency us: recv->parse={} parse->decision={}", m_symbol.name,
+            static_cast<int64_t>(last.tsUs - last.recvTsUs),
+            static_cast<int64_t>(NowUs() - last.tsUs));
+    }
+
+    const auto& vwapData = m_vwap.Compute(m_book, m_takerFee);
+    if (vwapData.empty()) {
+        if (m_venueEvents.empty())
+            return;
+        vwapBid = m_venueEvents.back().vwapBid;
+        vwapAsk = m_venueEvents.back().vwapAsk;
+    } else {
+        vwapBid = vwapData[m_sorBand].vwapBid;
+        vwapAsk = vwapData[m_sorBand].vwapAsk;
+    }
+
+    const auto acData = m_acTracker.ComputeRegression();
+
+    venueData.vwapBid = vwapBid;
+    venueData.vwapAsk = vwapAsk;
+    venueData.gammaTemp = acData.gammaTemp;
+    venueData.phiPerm = acData.phiPerm;
+    m_venueEvents.push_back(std::move(venueData));
+
+    if (ShouldUpdateSor()) {
+        LOG(info, "[{}] compute SOR value based on {} events", m_symbol.name,
+            m_venueEvents.size());
+        m_sor.Compute(m_venueEvents);
+        m_acTracker.ClearEvents();
+        if (!m_venueEvents.empty())
+            m_venueEvents.erase(m_venueEvents.begin() + 1, m_venueEvents.end());
+        SorUpdated();
+    }
+}
+
+}  // namespace engine
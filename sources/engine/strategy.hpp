@@ -0,0 +1,97 @@
+#pragma once
+
+#include <chrono>
+#include <common/event/normalized_event.hpp>
+#include <common/exchange/exchange_params.hpp>
+#include <core/algorithm/ac.hpp>
+#include <core/algorithm/order_book.hpp>
+#include <core/algorithm/sor.hpp>
+#include <core/algorithm/vwap.hpp>
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace engine {
+
+/**
+ * @brief Configuration of the strategy of a symbol.
+ */
+struct StrategyConfig {
+    common::exchange::SymbolParams symbol;             /**< Symbol the strategy trades. */
+    std::string_view venue;                            /**< Venue of the symbol. */
+    common::exchange::ExchangeParams params;           /**< Fees and SOR parameters. */
+    std::vector<float> vwapBands{0.01f, 0.02f, 0.05f}; /**< VWAP band widths (fraction of mid). */
+    std::size_t sorBand = 2;                           /**< Index of the band that feeds SOR. */
+    core::algorithm::ACConfig ac;                      /**< Almgren–Chriss regression settings. */
+};
+
+/**
+ * @brief Strategy state of one symbol.
+ *
+ * Keeps the L2 order book of the symbol, computes VWAP bands from it, feeds the
+ * Almgren–Chriss tracker with trades and book updates, and runs Smart Order
+ * Routing (SOR) at most every 200 ms. Depth and trade events of all streams of
+ * the symbol go to the same state, so impact estimates see both.
+ */
+class Strategy final {
+public:
+    /**
+     * @brief Constructs the strategy of a symbol.
+     *
+     * @param config Strategy configuration.
+     * @throws std::invalid_argument if the configured SOR band does not exist.
+     */
+    explicit Strategy(const StrategyConfig& config);
+
+    /**
+     * @brief Returns the symbol of the strategy.
+     */
+    inline std::string_view Symbol() const noexcept { return m_symbol.name; }
+
+    /**
+     * @brief Applies the events of one frame and updates VWAP, Almgren–Chriss and SOR.
+     *
+     * @param events Normalized events of the frame, not empty.
+     */
+    void OnEvents(std::span<const common::event::NormalizedEvent> events);
+
+    /**
+     * @brief Drops the book and the Almgren–Chriss state after a stream was lost.
+     */
+    void OnResync();
+
+private:
+    /**
+     * @brief Checks whether the Smart Order Router (SOR) should be updated.
+     *
+     * Uses a 200ms minimum interval between updates.
+     *
+     * @return True if SOR should be updated; false otherwise.
+     */
+    inline bool ShouldUpdateSor() noexcept {
+        using namespace std::chrono_literals;
+        return std::chrono::steady_clock::now() - m_sorLastUpdate >= 200ms;
+    }
+
+    /**
+     * @brief Updates the timestamp for the last SOR update.
+     */
+    inline void SorUpdated() noexcept { m_sorLastUpdate = std::chrono::steady_clock::now(); }
+
+private:
+    common::exchange::SymbolParams m_symbol;           /**< Symbol of the strategy. */
+    std::string_view m_venue;                          /**< Venue of the symbol. */
+    float m_takerFee;                                  /**< Taker fee of the venue. */
+    std::vector<core::algorithm::VenueData>
+        m_venueEvents;                                 /**< Venue-specific events for SOR/VWAP. */
+    core::algorithm::OrderBook m_book;                 /**< L2 order book of the symbol. */
+    core::algorithm::VWAP m_vwap;                      /**< VWAP calculator. */
+    std::size_t m_sorBand;                             /**< VWAP band used for SOR. */
+    core::algorithm::AlmgrenChrissTracker m_acTracker; /**< Almgren–Chriss model tracker. */
+
+    std::chrono::steady_clock::time_point m_sorLastUpdate; /**< Timestamp of last SOR update. */
+    core::algorithm::SOR m_sor;                            /**< Smart Order Router instance. */
+};
+
+}  // namespace engine
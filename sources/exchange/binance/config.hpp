@@ -0,0 +1,33 @@
+#pragma once
+
+#include <common/exchange/exchange_params.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <network/capture/replay_session.hpp>
+#include <network/websockets/reconnect_policy.hpp>
+#include <optional>
+#include <string>
+
+#include "generator.hpp"
+
+namespace exchange::binance {
+
+/**
+ * @brief Runtime configuration of a Binance handler and its connector.
+ */
+struct Config {
+    common::exchange::SymbolParams symbol; /**< Symbol served by the handler. */
+    std::filesystem::path captureDir;      /**< If set, streams are recorded here. */
+    std::filesystem::path replayDir;       /**< If set, streams are replayed from here. */
+    network::capture::Pace replayPace{network::capture::Pace::Recorded}; /**< Replay speed. */
+    std::optional<GeneratorConfig> synthetic; /**< If set, streams are generated instead. */
+    std::string host;                         /**< Server host, the Binance one if empty. */
+    uint16_t port = 0;                        /**< Server port, the Binance one if 0. */
+    std::size_t frameQueueSize = 1024;                 /**< Raw frames buffered per connection. */
+    std::size_t eventQueueSize = 1024;                 /**< Parsed frames buffered per handler. */
+    std::size_t streamsPerConnection = 0;              /**< Streams per combined socket, 0 = off. */
+    network::websockets::ReconnectPolicy reconnect;    /**< Reconnect and liveness settings. */
+};
+
+}  // namespace exchange::binance
@@ -1,13 +1,245 @@
 #include "connector.hpp"
 
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <boost/asio/post.hpp>
+#include <core/log/log.hpp>
+#include <network/capture/recorder.hpp>
+#include <network/capture/replay_session.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "info.hpp"
+#include "synthetic_session.hpp"
 
 namespace exchange::binance {
-Connector::Connector(boost::asio::io_context& ioc) : m_ioc(ioc) {}
+namespace {
+constexpr std::string_view wsPrefix = "/ws/";
+constexpr std::size_t maxCaptureName = 128;
+}  // namespace
+
+Connector::Connector(boost::asio::io_context& ioc, const Config& config)
+    : m_ioc(ioc), m_config(config) {}
 
 void Connector::Subscribe(std::string_view target, core::interface::INotifier* notifier) {
-    auto session = std::make_unique<network::websockets::Session>(m_ioc);
-    session->Connect(host, target, port, notifier);
-    m_handlers.emplace_back(std::move(session), notifier);
+    if (m_config.streamsPerConnection == 0) {
+        Connect(target, notifier);
+        return;
+    }
+
+    if (target.starts_with(wsPrefix)) {
+        target.remove_prefix(wsPrefix.size());
+    }
+    if (m_pending.empty()) {
+        boost::asio::post(m_ioc, [this] { ConnectPending(); });
+    }
+    m_pending.emplace_back(std::string{target}, notifier);
+}
+
+void Connector::AddStream(std::string_view stream, core::interface::INotifier* notifier,
+                          RequestCallback done) {
+    boost::asio::post(m_ioc, [this, stream = std::string{stream}, notifier,
+                              done = std::move(done)]() mutable {
+        if (m_config.streamsPerConnection == 0) {
+            Connect(fmt::format("{}{}", wsPrefix, stream), notifier);
+        } else if (Subscribed(stream)) {
+            // a second SUBSCRIBE would be rejected and its rollback drop the working route
+            LOG(warn, "Cannot add stream {}: already subscribed", stream);
+            if (done) {
+                done(false);
+            }
+            return;
+        } else if (!m_pending.empty()) {
+            // the initial connections are not open yet, join them
+            m_pending.emplace_back(std::move(stream), notifier);
+        } else {
+            const auto it = std::ranges::find_if(m_combined, [this](const Combined& c) {
+                return c.multiplexer->Size() < m_config.streamsPerConnection;
+            });
+            if (it != m_combined.end()) {
+                // route right away, the first frames may arrive before the response, and
+                // let a reconnect in the meantime subscribe the stream through its target
+                it->multiplexer->Add(stream, notifier);
+                it->session->SetTarget(it->multiplexer->Target());
+                Request(*it, "SUBSCRIBE", stream,
+                        [stream, multiplexer = it->multiplexer.get(), session = it->session,
+                         done = std::move(done)](bool accepted) {
+                            // rejected or lost with its connection, the next one must not have it
+                            if (!accepted) {
+                                multiplexer->Remove(stream);
+                                session->SetTarget(multiplexer->Target());
+                            }
+                            if (done) {
+                                done(accepted);
+                            }
+                        });
+                return;
+            }
+            ConnectCombined(std::array{PendingStream{std::move(stream), notifier}});
+        }
+
+        if (done) {
+            done(true);
+        }
+    });
+}
+
+void Connector::RemoveStream(std::string_view stream, RequestCallback done) {
+    boost::asio::post(m_ioc, [this, stream = std::string{stream}, done = std::move(done)] {
+        const auto queued = std::erase_if(
+            m_pending, [&stream](const PendingStream& s) { return s.name == stream; });
+        if (queued != 0) {
+            if (done) {
+                done(true);
+            }
+            return;
+        }
+
+        const auto it = std::ranges::find_if(
+            m_combined, [&stream](const Combined& c) { return c.multiplexer->Contains(stream); });
+        if (it == m_combined.end()) {
+            LOG(warn, "Cannot remove stream {}: not subscribed", stream);
+            if (done) {
+                done(false);
+            }
+            return;
+        }
+
+        Request(*it, "UNSUBSCRIBE", stream,
+                [stream, multiplexer = it->multiplexer.get(), session = it->session,
+                 done](bool accepted) {
+                    // otherwise the stream stays routed and the next connection subscribes it
+                    if (accepted) {
+                        multiplexer->Remove(stream);
+                        session->SetTarget(multiplexer->Target());
+                    }
+                    if (done) {
+                        done(accepted);
+                    }
+                });
+    });
+}
+
+bool Connector::Subscribed(std::string_view stream) const {
+    return std::ranges::any_of(m_pending,
+                               [stream](const PendingStream& s) { return s.name == stream; }) ||
+           std::ranges::any_of(
+               m_combined, [stream](const Combined& c) { return c.multiplexer->Contains(stream); });
+}
+
+core::interface::ISession& Connector::Connect(std::string_view target,
+                                              core::interface::INotifier* notifier) {
+    std::unique_ptr<core::interface::ISession> session;
+
+    if (m_config.synthetic) {
+        session = std::make_unique<SyntheticSession>(m_ioc, *m_config.synthetic);
+    } else if (!m_config.replayDir.empty()) {
+        session = std::make_unique<network::capture::ReplaySession>(
+            m_ioc, CapturePath(m_config.replayDir, target), m_config.replayPace);
+    } else if (!m_config.captureDir.empty()) {
+        session = std::make_unique<network::websockets::Session>(
+            m_ioc,
+            std::make_unique<network::capture::Recorder>(CapturePath(m_config.captureDir, target)),
+            m_config.reconnect);
+    } else {
+        session = std::make_unique<network::websockets::Session>(m_ioc, nullptr,
+                                                                 m_config.reconnect);
+    }
+
+    session->Connect(m_config.host.empty() ? host : std::string_view{m_config.host}, target,
+                     m_config.port == 0 ? port : m_config.port, notifier);
+    return *m_handlers.emplace_back(std::move(session), notifier).session;
+}
+
+void Connector::ConnectCombined(std::span<const PendingStream> streams) {
+    auto multiplexer = std::make_unique<Multiplexer>();
+    for (const auto& stream : streams) {
+        multiplexer->Add(stream.name, stream.notifier);
+    }
+    multiplexer->SetResponseCallback(
+        [this](uint64_t id, bool accepted) { OnResponse(id, accepted); });
+    multiplexer->SetClosedCallback(
+        [this, connection = multiplexer.get()] { FailRequests(connection); });
+
+    LOG(info, "Connecting {} combined streams: {}", multiplexer->Size(), multiplexer->Target());
+    auto& session = Connect(multiplexer->Target(), multiplexer.get());
+    m_combined.emplace_back(std::move(multiplexer), &session);
+}
+
+void Connector::ConnectPending() {
+    const std::span<const PendingStream> pending{m_pending};
+    for (std::size_t first = 0; first < pending.size(); first += m_config.streamsPerConnection) {
+        const auto count = std::min(m_config.streamsPerConnection, pending.size() - first);
+        ConnectCombined(pending.subspan(first, count));
+    }
+    m_pending.clear();
+}
+
+void Connector::Request(Combined& connection, std::string_view method, std::string_view stream,
+                        RequestCallback done) {
+    // a replay or a generator cannot answer, requests only change the routing
+    if (!m_config.replayDir.empty() || m_config.synthetic) {
+        done(true);
+        return;
+    }
+
+    const auto id = m_nextRequestId++;
+    m_requests.emplace(id, PendingRequest{connection.multiplexer.get(), std::move(done)});
+    connection.session->Send(
+        fmt::format(R"({{"method":"{}","params":["{}"],"id":{}}})", method, stream, id));
+    LOG(info, "Sent {} {} as request {}", method, stream, id);
+}
+
+void Connector::OnResponse(uint64_t id, bool accepted) {
+    const auto it = m_requests.find(id);
+    if (it == m_requests.end()) {
+        LOG(warn, "Got response to unknown request {}", id);
+        return;
+    }
+
+    if (!accepted) {
+        LOG(err, "Request {} was rejected", id);
+    }
+    auto done = std::move(it->second.done);
+    m_requests.erase(it);
+    done(accepted);
+}
+
+void Connector::FailRequests(const Multiplexer* connection) {
+    // collect first, a callback may send the next request
+    std::vector<std::pair<uint64_t, RequestCallback>> failed;
+    std::erase_if(m_requests, [connection, &failed](auto& request) {
+        if (request.second.connection != connection) {
+            return false;
+        }
+        failed.emplace_back(request.first, std::move(request.second.done));
+        return true;
+    });
+
+    for (auto& [id, done] : failed) {
+        LOG(warn, "Request {} failed: the connection was lost", id);
+        done(false);
+    }
+}
+
+std::filesystem::path Connector::CapturePath(const std::filesystem::path& dir,
+                                             std::string_view target) {
+    const auto start = target.find_first_not_of('/');
+    std::string name{start == std::string_view::npos ? target : target.substr(start)};
+    std::ranges::replace_if(
+        name, [](char c) { return c == '/' || c == '?' || c == '&' || c == '='; }, '_');
+
+    // combined-stream targets easily exceed file name limits, keep a prefix and a stable hash
+    if (name.size() > maxCaptureName) {
+        uint64_t hash = 0xcbf29ce484222325;  // FNV-1a
+        for (const char c : name) {
+            hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001b3;
+        }
+        name = fmt::format("{}_{:016x}", name.substr(0, maxCaptureName - 17), hash);
+    }
+    return dir / (name + ".cap");
 }
 }  // namespace exchange::binance
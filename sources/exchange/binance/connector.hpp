@@ -1,8 +1,19 @@
 #pragma once
 
 #include <core/interface/connector.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
 #include <network/websockets/session.hpp>
+#include <span>
+#include <string>
 #include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "config.hpp"
+#include "multiplexer.hpp"
 
 namespace exchange::binance {
 
@@ -11,7 +22,19 @@ namespace exchange::binance {
  *
  * The Connector class manages subscriptions to Binance market data streams
  * and dispatches events via INotifier callbacks. It uses Boost.Asio for
- * asynchronous network operations.
+ * asynchronous network operations. Depending on the configuration, streams
+ * are recorded to capture files, or replayed from them or generated by a
+ * SyntheticSession instead of the network.
+ *
+ * With Config::streamsPerConnection set, subscriptions are combined: targets are
+ * queued and, once the io_context runs, packed into combined-stream connections
+ * of up to that many streams, each demultiplexed by a Multiplexer. A connector can
+ * be shared by several handlers so that all their streams share the connections.
+ *
+ * Streams of combined connections can be added and removed at runtime with
+ * AddStream()/RemoveStream(), which send SUBSCRIBE/UNSUBSCRIBE requests on a live
+ * connection instead of reconnecting. Requests still waiting for a response when
+ * their connection is lost fail.
  */
 class Connector final : public core::interface::IConnector {
 public:
@@ -19,20 +42,149 @@ public:
      * @brief Constructs a Binance connector.
      *
      * @param ioc Reference to an existing Boost.Asio io_context for asynchronous operations.
+     * @param config Capture and replay configuration.
      */
-    Connector(boost::asio::io_context& ioc);
+    Connector(boost::asio::io_context& ioc, const Config& config);
 
     /**
      * @brief Subscribes to a specific target (symbol or channel) on Binance.
      *
+     * In the combined mode the target ("/ws/<stream>" or "<stream>") is only queued
+     * and connected together with the other targets queued before the io_context
+     * gets to run the connection.
+     *
      * @param target The subscription target (e.g., trading symbol or channel).
      * @param notifier Pointer to an INotifier instance for receiving events.
      */
     void Subscribe(std::string_view target, core::interface::INotifier* notifier) override;
 
+    /**
+     * @brief Callback invoked when a stream request completes.
+     *
+     * @param accepted True if the exchange accepted the request; otherwise false.
+     */
+    using RequestCallback = std::function<void(bool accepted)>;
+
+    /**
+     * @brief Adds a stream to a live combined connection. Thread-safe.
+     *
+     * The stream goes to the first connection with fewer than
+     * Config::streamsPerConnection streams via a SUBSCRIBE request; if all are full,
+     * a new connection is opened. Without the combined mode a new connection is
+     * opened as with Subscribe(). Adding a stream that is already subscribed or
+     * queued fails. A reconnect before the response subscribes the stream through
+     * the connection target; a rejected or lost request removes it again.
+     *
+     * @param stream Stream name, e.g. "ethusdt@trade".
+     * @param notifier Notifier receiving the payloads of the stream.
+     * @param done Optional callback invoked on the io_context with the result.
+     */
+    void AddStream(std::string_view stream, core::interface::INotifier* notifier,
+                   RequestCallback done = {});
+
+    /**
+     * @brief Removes a stream from its combined connection via UNSUBSCRIBE. Thread-safe.
+     *
+     * The stream is routed until the exchange confirms the request. A stream still
+     * queued for the initial connections is dropped from the queue.
+     *
+     * @param stream Stream name.
+     * @param done Optional callback invoked on the io_context with the result.
+     */
+    void RemoveStream(std::string_view stream, RequestCallback done = {});
+
+private:
+    /**
+     * @brief A stream waiting for a combined-stream connection.
+     */
+    struct PendingStream {
+        std::string name;                     /**< Stream name. */
+        core::interface::INotifier* notifier; /**< Notifier of the stream. */
+    };
+
+    /**
+     * @brief A SUBSCRIBE or UNSUBSCRIBE request awaiting its response.
+     */
+    struct PendingRequest {
+        const Multiplexer* connection; /**< Router of the connection it was sent on. */
+        RequestCallback done;          /**< Callback of the request. */
+    };
+
+    /**
+     * @brief A combined-stream connection.
+     */
+    struct Combined {
+        std::unique_ptr<Multiplexer> multiplexer; /**< Router of the connection. */
+        core::interface::ISession* session;       /**< Session of the connection. */
+    };
+
+    /**
+     * @brief Checks whether a stream is queued or routed by a combined connection.
+     */
+    bool Subscribed(std::string_view stream) const;
+
+    /**
+     * @brief Connects a session to a target, recording or replaying it if configured.
+     *
+     * @param target Target path.
+     * @param notifier Notifier of the session.
+     * @return The connected session.
+     */
+    core::interface::ISession& Connect(std::string_view target,
+                                       core::interface::INotifier* notifier);
+
+    /**
+     * @brief Opens a combined-stream connection for the given streams.
+     */
+    void ConnectCombined(std::span<const PendingStream> streams);
+
+    /**
+     * @brief Packs the queued streams into combined-stream connections.
+     */
+    void ConnectPending();
+
+    /**
+     * @brief Sends a SUBSCRIBE or UNSUBSCRIBE request for a stream.
+     *
+     * @param connection Connection the request is sent on.
+     * @param method Request method.
+     * @param stream Stream name.
+     * @param done Callback invoked with the response.
+     */
+    void Request(Combined& connection, std::string_view method, std::string_view stream,
+                 RequestCallback done);
+
+    /**
+     * @brief Completes the request matching a response.
+     */
+    void OnResponse(uint64_t id, bool accepted);
+
+    /**
+     * @brief Fails the requests sent on a connection that was lost.
+     *
+     * @param connection Router of the connection.
+     */
+    void FailRequests(const Multiplexer* connection);
+
+    /**
+     * @brief Builds the capture file path for a subscription target.
+     *
+     * @param dir Capture directory.
+     * @param target The subscription target, e.g., "/ws/ethusdt@trade".
+     * @return Path of the capture file inside `dir`.
+     */
+    static std::filesystem::path CapturePath(const std::filesystem::path& dir,
+                                             std::string_view target);
+
 private:
     boost::asio::io_context&
         m_ioc; /**< Reference to the Boost.Asio IO context used for async operations. */
+    Config m_config; /**< Capture and replay configuration. */
+
+    std::vector<PendingStream> m_pending;                    /**< Streams queued to connect. */
+    std::vector<Combined> m_combined;                        /**< Combined-stream connections. */
+    std::unordered_map<uint64_t, PendingRequest> m_requests; /**< Requests awaiting responses. */
+    uint64_t m_nextRequestId = 1;                            /**< Id of the next request. */
 };
 
 }  // namespace exchange::binance
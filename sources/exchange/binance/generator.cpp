@@ -0,0 +1,197 @@
+#include "generator.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <common/decimal/decimal.hpp>
+#include <iterator>
+#include <stdexcept>
+
+namespace exchange::binance {
+namespace {
+constexpr std::string_view wsPrefix = "/ws/";
+constexpr std::string_view combinedPrefix = "/stream?streams=";
+constexpr uint8_t feedDecimals = 8; /**< Binance pads all numbers to 8 decimals. */
+
+/**
+ * @brief Appends a fixed-point value as a decimal string padded like the Binance feed.
+ */
+void AppendDecimal(std::string& out, int64_t value, uint8_t decimals) {
+    const auto scale = common::decimal::Pow10(decimals);
+    fmt::format_to(std::back_inserter(out), "{}.{:0{}}", value / scale, value % scale,
+                   decimals);
+    if (decimals < feedDecimals) {
+        out.append(feedDecimals - decimals, '0');
+    }
+}
+
+uint64_t NowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+}  // namespace
+
+Generator::Generator(const GeneratorConfig& config, std::string_view target)
+    : m_config(config), m_rng(config.seed != 0 ? config.seed : std::random_device{}()) {
+    SetTarget(target);
+}
+
+void Generator::SetTarget(std::string_view target) {
+    m_combined = target.starts_with(combinedPrefix);
+    if (m_combined) {
+        target.remove_prefix(combinedPrefix.size());
+    } else if (target.starts_with(wsPrefix)) {
+        target.remove_prefix(wsPrefix.size());
+    }
+
+    std::vector<Stream> streams;
+    while (!target.empty()) {
+        const auto slash = target.find('/');
+        const auto name = target.substr(0, slash);
+        target.remove_prefix(slash == std::string_view::npos ? target.size() : slash + 1);
+
+        const auto existing =
+            std::ranges::find_if(m_streams, [name](const Stream& s) { return s.name == name; });
+        if (existing != m_streams.end()) {
+            streams.push_back(*existing);
+            continue;
+        }
+
+        const auto at = name.find('@');
+        if (at == std::string_view::npos) {
+            throw std::invalid_argument{fmt::format("Cannot generate stream {}", name)};
+        }
+        const auto symbol = name.substr(0, at);
+        auto kind = name.substr(at + 1);
+
+        std::size_t levels = 0;
+        if (kind.starts_with("depth")) {
+            kind.remove_prefix(std::string_view{"depth"}.size());
+            while (!kind.empty() && std::isdigit(static_cast<unsigned char>(kind.front()))) {
+                levels = levels * 10 + static_cast<std::size_t>(kind.front() - '0');
+                kind.remove_prefix(1);
+            }
+            // diff depth streams carry updates, not snapshots
+            if (levels == 0) {
+                throw std::invalid_argument{fmt::format("Cannot generate stream {}", name)};
+            }
+        } else if (!kind.starts_with("trade")) {
+            throw std::invalid_argument{fmt::format("Cannot generate stream {}", name)};
+        }
+
+        auto market = std::ranges::find_if(
+            m_markets, [symbol](const Market& m) { return m.symbol == symbol; });
+        if (market == m_markets.end()) {
+            const auto mid = m_config.startPrice *
+                             static_cast<double>(common::decimal::Pow10(m_config.priceDecimals));
+            m_markets.push_back({std::string{symbol}, mid, 0, 0});
+            Walk(m_markets.back());
+            market = std::prev(m_markets.end());
+        }
+
+        // ids continue from somewhere in the range of the live feed
+        const auto firstId = std::uniform_int_distribution<uint64_t>{1'000'000'000,
+                                                                     9'000'000'000}(m_rng);
+        streams.push_back({std::string{name},
+                           static_cast<std::size_t>(std::distance(m_markets.begin(), market)),
+                           levels, firstId});
+    }
+    m_streams = std::move(streams);
+}
+
+std::chrono::nanoseconds Generator::Next(std::string& frame) {
+    frame.clear();
+    if (m_streams.empty()) {
+        return std::chrono::seconds{1};
+    }
+
+    if (m_burstLeft > 0) {
+        --m_burstLeft;
+    } else if (std::bernoulli_distribution{m_config.burstProbability}(m_rng)) {
+        m_burstLeft = m_config.burstMessages * m_streams.size();
+    }
+    const auto rate = m_config.rate * static_cast<double>(m_streams.size()) *
+                      (m_burstLeft > 0 ? m_config.burstFactor : 1.0);
+    const auto gap = std::exponential_distribution<>{rate}(m_rng);
+
+    auto& stream =
+        m_streams[std::uniform_int_distribution<std::size_t>{0, m_streams.size() - 1}(m_rng)];
+    auto& market = m_markets[stream.market];
+    Walk(market);
+
+    if (m_combined) {
+        fmt::format_to(std::back_inserter(frame), R"({{"stream":"{}","data":)", stream.name);
+    }
+    if (stream.levels != 0) {
+        WriteDepth(stream, market, frame);
+    } else {
+        WriteTrade(stream, market, frame);
+    }
+    if (m_combined) {
+        frame += '}';
+    }
+
+    return std::chrono::nanoseconds{static_cast<int64_t>(gap * 1e9)};
+}
+
+void Generator::Walk(Market& market) {
+    market.mid = std::max(market.mid * std::exp(m_config.volatility * m_normal(m_rng)), 100.0);
+
+    // liquid books are mostly one tick wide
+    const auto spread = 1 + std::geometric_distribution<int64_t>{0.7}(m_rng);
+    market.bid = std::llround(market.mid - static_cast<double>(spread) / 2);
+    market.ask = market.bid + spread;
+}
+
+void Generator::WriteDepth(Stream& stream, const Market& market, std::string& out) {
+    const auto writeSide = [&](int64_t price, int64_t direction) {
+        std::geometric_distribution<int64_t> gap{0.5};
+        for (std::size_t i = 0; i < stream.levels; ++i) {
+            if (i != 0) {
+                out += ',';
+            }
+            // resting size grows away from the touch
+            const auto depth = static_cast<double>(i) / static_cast<double>(stream.levels);
+            out += "[\"";
+            AppendDecimal(out, price, m_config.priceDecimals);
+            out += "\",\"";
+            AppendDecimal(out, Size(m_config.levelSize * (1 + depth), 1), m_config.sizeDecimals);
+            out += "\"]";
+            price += direction * (1 + gap(m_rng));
+        }
+    };
+
+    fmt::format_to(std::back_inserter(out), R"({{"lastUpdateId":{},"bids":[)", stream.nextId++);
+    writeSide(market.bid, -1);
+    out += R"(],"asks":[)";
+    writeSide(market.ask, 1);
+    out += "]}";
+}
+
+void Generator::WriteTrade(Stream& stream, const Market& market, std::string& out) {
+    const auto buy = std::bernoulli_distribution{0.5}(m_rng);
+    const auto ms = NowMs();
+
+    fmt::format_to(std::back_inserter(out), R"({{"e":"trade","E":{},"s":")", ms);
+    std::ranges::transform(market.symbol, std::back_inserter(out), [](char c) {
+        return static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    });
+    fmt::format_to(std::back_inserter(out), R"(","t":{},"p":")", stream.nextId++);
+    AppendDecimal(out, buy ? market.ask : market.bid, m_config.priceDecimals);
+    out += R"(","q":")";
+    AppendDecimal(out, Size(m_config.tradeSize, 1.5), m_config.sizeDecimals);
+    // the buyer is the maker when a seller takes the bid
+    fmt::format_to(std::back_inserter(out), R"(","T":{},"m":{},"M":true}})", ms, !buy);
+}
+
+int64_t Generator::Size(double mean, double sigma) {
+    std::lognormal_distribution<> size{std::log(mean) - sigma * sigma / 2, sigma};
+    const auto lots =
+        size(m_rng) * static_cast<double>(common::decimal::Pow10(m_config.sizeDecimals));
+    return std::max<int64_t>(1, std::llround(lots));
+}
+
+}  // namespace exchange::binance
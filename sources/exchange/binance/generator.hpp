@@ -0,0 +1,135 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace exchange::binance {
+
+/**
+ * @brief Settings of the synthetic market data generator.
+ */
+struct GeneratorConfig {
+    double rate = 10;                /**< Mean messages per second of every stream. */
+    double burstProbability = 0.001; /**< Chance of a message to start a burst. */
+    double burstFactor = 50;         /**< Rate multiplier during a burst. */
+    std::size_t burstMessages = 200; /**< Messages of every stream in a burst. */
+    double startPrice = 2450;        /**< Initial mid price of every symbol. */
+    double volatility = 5e-5;        /**< Std dev of the relative mid move per message. */
+    uint8_t priceDecimals = 2;       /**< Prices are multiples of 10^-priceDecimals. */
+    uint8_t sizeDecimals = 4;        /**< Sizes are multiples of 10^-sizeDecimals. */
+    double levelSize = 3;            /**< Mean size of a book level at the top. */
+    double tradeSize = 0.5;          /**< Mean size of a trade. */
+    uint64_t seed = 0;               /**< Random seed, 0 = nondeterministic. */
+};
+
+/**
+ * @brief Generator of Binance-format market data for load testing.
+ *
+ * The generator serves the streams of a Binance target, a single stream
+ * ("/ws/ethusdt@depth20@100ms") or combined streams ("/stream?streams=a/b/c"), the
+ * latter wrapped into `{"stream":...,"data":...}` envelopes. Depth streams
+ * (`<symbol>@depth<N>...`) get partial book snapshots with consecutive update ids,
+ * trade streams (`<symbol>@trade...`) get trades at the touch.
+ *
+ * Every symbol of the target follows its own random walk of the mid price. The
+ * spread is one tick plus a geometric number of ticks, book levels are spaced by
+ * geometric gaps and sized lognormally, growing with the distance from the touch;
+ * trade sizes are lognormal with a heavy tail. Message times form a Poisson process
+ * of `rate` messages per stream per second, sped up by `burstFactor` during bursts.
+ *
+ * Symbols of separate generators, e.g. of the depth and the trade connection of a
+ * symbol, walk independently.
+ */
+class Generator final {
+public:
+    /**
+     * @brief Constructs a generator for the streams of a target.
+     *
+     * @param config Generator settings.
+     * @param target Binance target path.
+     * @throws std::invalid_argument If a stream is neither a depth nor a trade stream.
+     */
+    Generator(const GeneratorConfig& config, std::string_view target);
+
+    /**
+     * @brief Changes the served streams, e.g. after SUBSCRIBE/UNSUBSCRIBE.
+     *
+     * Symbols and streams that remain keep their state.
+     *
+     * @param target Binance target path.
+     * @throws std::invalid_argument If a stream is neither a depth nor a trade stream.
+     */
+    void SetTarget(std::string_view target);
+
+    /**
+     * @brief Writes the next message of a randomly chosen stream.
+     *
+     * Without streams the frame is left empty.
+     *
+     * @param frame Replaced with the message, as received from the target.
+     * @return Time between the previous message and this one.
+     */
+    std::chrono::nanoseconds Next(std::string& frame);
+
+    /**
+     * @brief Returns the number of served streams.
+     */
+    inline std::size_t Streams() const noexcept { return m_streams.size(); }
+
+private:
+    /**
+     * @brief Price state of a symbol.
+     */
+    struct Market {
+        std::string symbol; /**< Symbol name, e.g. "ethusdt". */
+        double mid;         /**< Mid price in ticks. */
+        int64_t bid;        /**< Best bid in ticks. */
+        int64_t ask;        /**< Best ask in ticks. */
+    };
+
+    /**
+     * @brief A served stream.
+     */
+    struct Stream {
+        std::string name;    /**< Stream name, e.g. "ethusdt@trade". */
+        std::size_t market;  /**< Index of the symbol in m_markets. */
+        std::size_t levels;  /**< Book levels per side, 0 for a trade stream. */
+        uint64_t nextId = 0; /**< Next update id or trade id. */
+    };
+
+    /**
+     * @brief Moves the mid price of a symbol and draws a new touch around it.
+     */
+    void Walk(Market& market);
+
+    /**
+     * @brief Appends a depth snapshot of a symbol.
+     */
+    void WriteDepth(Stream& stream, const Market& market, std::string& out);
+
+    /**
+     * @brief Appends a trade of a symbol.
+     */
+    void WriteTrade(Stream& stream, const Market& market, std::string& out);
+
+    /**
+     * @brief Draws a lognormal size with the given mean, in lots of at least one.
+     */
+    int64_t Size(double mean, double sigma);
+
+private:
+    GeneratorConfig m_config;                  /**< Generator settings. */
+    std::mt19937_64 m_rng;                     /**< Source of all randomness. */
+    std::normal_distribution<> m_normal{0, 1}; /**< Standard normal distribution. */
+    std::vector<Market> m_markets;             /**< Symbols of the served streams. */
+    std::vector<Stream> m_streams;             /**< Served streams. */
+    bool m_combined = false;                   /**< Messages are wrapped into envelopes. */
+    std::size_t m_burstLeft = 0;               /**< Messages left in the current burst. */
+};
+
+}  // namespace exchange::binance
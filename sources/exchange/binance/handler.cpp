@@ -1,136 +1,185 @@
 #include "handler.hpp"
 
 #include <core/log/log.hpp>
-#include <functional>
+#include <core/metrics/latency.hpp>
+#include <cstring>
 #include <magic_enum/magic_enum.hpp>
-
-#include "info.hpp"
+#include <stdexcept>
 
 namespace exchange::binance {
 namespace ceh = core::error_handling;
 
-Handler::Handler(boost::asio::io_context& ioc)
-    : m_connector(ioc),
-      m_sorLastUpdate(std::chrono::steady_clock::now()),
-      m_sor(params.lambda, params.targetAmount) {}
+template <Serializer... Serializers>
+BasicHandler<Serializers...>::BasicHandler(boost::asio::io_context& ioc, const Config& config)
+    : BasicHandler(std::make_shared<Connector>(ioc, config), config) {}
 
-void Handler::AddTarget(EventType evt, std::string_view target) {
-    using namespace std::placeholders;
+template <Serializer... Serializers>
+BasicHandler<Serializers...>::BasicHandler(std::shared_ptr<core::interface::IConnector> connector,
+                                           const Config& config)
+    : m_symbol(config.symbol),
+      m_frameQueueSize(config.frameQueueSize),
+      m_batches(config.eventQueueSize),
+      m_connector(std::move(connector)) {}
 
-    serializer_t serializer;
-    notifier_t notifier;
+template <Serializer... Serializers>
+void BasicHandler<Serializers...>::AddTarget(EventType evt, std::string_view target) {
     const auto idx = m_parsers.size();
 
-    switch (evt) {
-        case EventType::Depth:
-            serializer = std::make_unique<DepthSerializer>();
-            break;
-        case EventType::Trade:
-            serializer = std::make_unique<TradeSerializer>();
-            break;
-        default:
-            assert(0 && "Unexpected event type");
-            break;
+    // the serializer is picked once here, frames are parsed without a virtual call
+    const auto add = [&]<typename T>(std::in_place_type_t<T> type) {
+        if (T::type != evt) {
+            return false;
+        }
+        m_parsers.emplace_back(target, type, m_symbol, m_frameQueueSize);
+        return true;
+    };
+    if (!(add(std::in_place_type<Serializers>) || ...)) {
+        throw std::invalid_argument{"Unexpected event type"};
     }
 
-    notifier = std::make_unique<BaseNotifier>();
-    notifier->OnConnectionSuccessed = std::bind(&Handler::OnConnectionSuccessed, this, idx);
-    notifier->OnConnectionFailed = std::bind(&Handler::OnConnectionFailed, this, idx, _1);
-    notifier->OnReceiveSuccessed = std::bind(&Handler::OnReceiveSuccessed, this, idx, _1);
-    notifier->OnReceiveFailed = std::bind(&Handler::OnReceiveFailed, this, idx, _1);
-    notifier->OnStopRequested = std::bind(&Handler::OnStopRequsted, this, idx);
-    notifier->OnStop = std::bind(&Handler::OnStop, this, idx);
-
-    m_parsers.emplace_back(target, std::move(notifier), std::move(serializer), 0);
+    auto& notifier = m_parsers.back().notifier;
+    notifier.OnConnectionSuccessed = [this, idx] { OnConnectionSuccessed(idx); };
+    notifier.OnConnectionFailed = [this, idx](ceh::ErrorCode ec) { OnConnectionFailed(idx, ec); };
+    notifier.OnReceiveSuccessed = [this, idx](std::span<std::byte> data, uint64_t recvTsNs) {
+        OnReceiveSuccessed(idx, data, recvTsNs);
+    };
+    notifier.OnReceiveFailed = [this, idx](ceh::ErrorCode ec) { OnReceiveFailed(idx, ec); };
+    notifier.OnStopRequested = [this, idx] { return OnStopRequsted(idx); };
+    notifier.OnStop = [this, idx] { OnStop(idx); };
 }
 
-void Handler::Init() {
-    using namespace std::placeholders;
-
-    for (const auto& parser : m_parsers) {
+template <Serializer... Serializers>
+void BasicHandler<Serializers...>::Init() {
+    for (auto& parser : m_parsers) {
         LOG(info, "Created parser for target: {}", parser.target);
 
-        m_connector.Subscribe(parser.target, parser.notifier.get());
+        m_connector->Subscribe(parser.target, &parser.notifier);
     }
 }
 
-void Handler::OnConnectionSuccessed(size_t idx) {
-    LOG(info, "[{}] successfully connected", idx);
-}
+template <Serializer... Serializers>
+bool BasicHandler<Serializers...>::Parse() {
+    bool parsed = false;
 
-void Handler::OnConnectionFailed(size_t idx, ceh::ErrorCode ec) {
-    LOG(critical, "[{}] failed to connect. Ec: {}", idx, ec);
-    throw std::runtime_error{"Failed to establish connection to required resource"};
-}
+    for (size_t idx = 0; idx < m_parsers.size(); ++idx) {
+        auto& parser = m_parsers[idx];
+        auto* frame = parser.frames.Front();
+        if (frame == nullptr) {
+            continue;
+        }
 
-void Handler::OnReceiveSuccessed(size_t idx, std::span<std::byte> data) {
-    using event_t = common::event::NormalizedEvent;
+        // the consumer is behind, keep the frame until there is room for its events
+        auto* batch = m_batches.BeginPush();
+        if (batch == nullptr) {
+            return parsed;
+        }
+        batch->events.clear();
+        batch->recvTsUs = frame->recvTsNs / 1000;
+        batch->stream = idx;
+        // streams joining an open combined connection start at any generation
+        batch->resync = parser.parsed && *parser.parsed != frame->connection;
+        parser.parsed = frame->connection;
+        if (batch->resync) [[unlikely]] {
+            LOG(info, "[{}] first frame after reconnect, resetting the stream state", idx);
+            std::visit([](auto& serializer) { serializer.Reset(); }, parser.serializer);
+        }
 
-    auto& serializer = m_parsers[idx].serializer;
+        {
+            const core::metrics::ScopedLatency latency{core::metrics::Stage::Serialize};
+            const std::span data{frame->bytes.data(), frame->size};
+            // events are parsed straight into the slot, which keeps its capacity across frames
+            ceh::ErrorCode ec = ceh::ErrorCode::eUnexpected;
+            const auto serialized = std::visit(
+                [&](auto& serializer) {
+                    return serializer.Serialize(data, frame->recvTsNs, batch->events, ec);
+                },
+                parser.serializer);
+            if (!serialized) [[unlikely]] {
+                LOG(warn, "[{}] failed to seralize data. Ec: {}. Update statistic", idx, ec);
+                parser.errors.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        parser.frames.Pop();
+        m_framesParsed.store(m_framesParsed.load(std::memory_order_relaxed) + 1,
+                             std::memory_order_relaxed);
+        m_eventsParsed.store(m_eventsParsed.load(std::memory_order_relaxed) + batch->events.size(),
+                             std::memory_order_relaxed);
+        if (batch->resync || !batch->events.empty()) {
+            m_batches.EndPush();
+        }
+        parsed = true;
+    }
 
-    const auto onSuccess = [this, idx](const std::vector<event_t>& events) {
-        core::algorithm::VenueData venueData;
-        venueData.name = venue;
-        float vwapBid;
-        float vwapAsk;
+    return parsed;
+}
 
-        for (const auto& ne : events) {
-            LOG(trace, "[{}] got new normalized event: {}", idx, ne);
+template <Serializer... Serializers>
+auto BasicHandler<Serializers...>::GetStats() const noexcept -> Stats {
+    Stats stats{m_framesParsed.load(std::memory_order_relaxed),
+                m_eventsParsed.load(std::memory_order_relaxed), 0, 0};
+    for (const auto& parser : m_parsers) {
+        stats.framesDropped += parser.dropped.load(std::memory_order_relaxed);
+        stats.errors += parser.errors.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
 
-            m_vwap.AddEvent(ne);
-            m_acTracker.AddEvent(ne);
-        }
+template <Serializer... Serializers>
+void BasicHandler<Serializers...>::OnConnectionSuccessed(size_t idx) {
+    // frames pushed from now on belong to the new connection
+    const auto connection = ++m_parsers[idx].connections;
+    LOG(info, "[{}] successfully connected. Connection: {}", idx, connection);
+}
 
-        const auto vwapData = m_vwap.Compute(params.takerFee);
-        if (vwapData.empty()) {
-            if (m_venueEvents.empty())
-                return;
-            vwapBid = m_venueEvents.back().vwapBid;
-            vwapAsk = m_venueEvents.back().vwapAsk;
-        } else {
-            vwapBid = vwapData[2].vwapBid;  // take 5%
-            vwapAsk = vwapData[2].vwapAsk;
-        }
+template <Serializer... Serializers>
+void BasicHandler<Serializers...>::OnConnectionFailed(size_t idx, ceh::ErrorCode ec) {
+    LOG(err, "[{}] failed to connect. Ec: {}", idx, ec);
+}
 
-        const auto acData = m_acTracker.ComputeRegression();
-
-        venueData.vwapBid = vwapBid;
-        venueData.vwapAsk = vwapAsk;
-        venueData.gammaTemp = acData.gammaTemp;
-        venueData.phiPerm = acData.phiPerm;
-        m_venueEvents.push_back(std::move(venueData));
-
-        if (ShouldUpdateSor()) {
-            LOG(info, "[{}] compute SOR value based on {} events", idx, m_venueEvents.size());
-            m_sor.Compute(m_venueEvents);
-            m_acTracker.ClearEvents();
-            m_vwap.ClearEvents();
-            if (!m_venueEvents.empty())
-                m_venueEvents.erase(m_venueEvents.begin() + 1, m_venueEvents.end());
-            SorUpdated();
+template <Serializer... Serializers>
+void BasicHandler<Serializers...>::OnReceiveSuccessed(size_t idx, std::span<std::byte> data,
+                                                      uint64_t recvTsNs) {
+    auto& parser = m_parsers[idx];
+
+    auto* frame = parser.frames.BeginPush();
+    if (frame == nullptr) [[unlikely]] {
+        // a stalled parse stage drops every frame, log the first one and then every Nth
+        const auto dropped = parser.dropped.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (dropped % dropLogInterval == 1) {
+            LOG(warn, "[{}] frame queue is full, dropped {} frames so far", idx, dropped);
         }
-    };
-
-    const auto onFail = [this, idx](ceh::ErrorCode ec) {
-        LOG(warn, "[{}] failed to seralize data. Ec: {}. Update statistic", idx, ec);
-        ++m_parsers[idx].errors;
-    };
+        return;
+    }
 
-    serializer->Serialize(data, onSuccess, onFail);
+    // the serializer may read up to receivePadding bytes past the end
+    const auto capacity = data.size() + core::interface::receivePadding;
+    if (frame->bytes.size() < capacity) {
+        frame->bytes.resize(capacity);
+    }
+    std::memcpy(frame->bytes.data(), data.data(), data.size());
+    frame->size = data.size();
+    frame->recvTsNs = recvTsNs;
+    frame->connection = parser.connections;
+    parser.frames.EndPush();
 }
 
-void Handler::OnReceiveFailed(size_t idx, ceh::ErrorCode ec) {
+template <Serializer... Serializers>
+void BasicHandler<Serializers...>::OnReceiveFailed(size_t idx, ceh::ErrorCode ec) {
     LOG(warn, "[{}] failed to receive data. Ec: {}. Update statistic", idx, ec);
-    ++m_parsers[idx].errors;
+    m_parsers[idx].errors.fetch_add(1, std::memory_order_relaxed);
 }
 
-bool Handler::OnStopRequsted(size_t idx) {
-    const auto errors = m_parsers[idx].errors;
+template <Serializer... Serializers>
+bool BasicHandler<Serializers...>::OnStopRequsted(size_t idx) {
+    const auto errors = m_parsers[idx].errors.load(std::memory_order_relaxed);
     LOG(trace, "[{}] check for stop. Errors count: {}", idx, errors);
     return errors >= 30;
 }
 
-void Handler::OnStop(size_t idx) {
+template <Serializer... Serializers>
+void BasicHandler<Serializers...>::OnStop(size_t idx) {
     LOG(info, "[{}] finished", idx);
 }
+
+template class BasicHandler<DepthSerializer, TradeSerializer>;
 }  // namespace exchange::binance
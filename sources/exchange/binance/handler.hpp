@@ -1,17 +1,22 @@
 #pragma once
 
-#include <chrono>
+#include <atomic>
 #include <common/event/normalized_event.hpp>
-#include <core/algorithm/ac.hpp>
-#include <core/algorithm/sor.hpp>
-#include <core/algorithm/vwap.hpp>
+#include <core/concurrency/spsc_ring.hpp>
 #include <core/error_handling/error_handling.hpp>
+#include <core/interface/connector.hpp>
+#include <core/interface/event_source.hpp>
 #include <core/interface/handler.hpp>
 #include <core/interface/notifier.hpp>
 #include <cstdint>
+#include <deque>
 #include <memory>
+#include <optional>
+#include <utility>
+#include <variant>
 #include <vector>
 
+#include "config.hpp"
 #include "connector.hpp"
 #include "info.hpp"
 #include "notifier.hpp"
@@ -20,26 +25,66 @@
 namespace exchange::binance {
 
 /**
- * @brief Handler for Binance market events and trading logic.
+ * @brief Handler for Binance market data streams parsed by a fixed set of serializers.
  *
- * The Handler class manages subscriptions, event parsing, VWAP computation,
- * Almgren–Chriss tracking, and Smart Order Routing (SOR) updates for Binance.
- * It uses Boost.Asio for asynchronous operations.
+ * The Handler class manages subscriptions and turns the received frames of its
+ * streams into normalized events for Binance. It uses Boost.Asio for asynchronous
+ * operations.
+ *
+ * Work is split into stages connected by lock-free SPSC rings. The network thread
+ * only copies every received frame into the ring of its connection. Parse() turns
+ * frames into normalized events and pushes them as one batch per frame into the
+ * event ring, which is consumed through the IEventSource interface, usually by an
+ * engine::EventBus that feeds the strategy of the symbol. If the parse stage falls
+ * behind and a frame ring is full, new frames of that connection are dropped and
+ * counted rather than stalling the socket.
+ *
+ * Connections reconnect on their own (see network::websockets::ReconnectPolicy).
+ * Frames are tagged with the connection generation they arrived on, so when the
+ * first frame of a new connection reaches the parse stage, the serializer forgets
+ * the update sequence of the old one and the batch is marked for a resync, so the
+ * strategy drops its state instead of mixing data from both sides of the gap.
+ *
+ * The serializers are template parameters, so every connection holds its serializer
+ * by value in a variant and the parse stage dispatches on the variant into the
+ * final serializer type instead of a virtual ISerializer call. The receive side
+ * stays type-erased: sessions are runtime ISession objects created by the
+ * connector, and they hand frames over through the std::function callbacks of the
+ * connection's BaseNotifier, one indirect call per frame. Events are parsed
+ * straight into the batch slot of the ring, so the parse stage makes no heap
+ * allocation once the slots have grown.
+ *
+ * @tparam Serializers Serializers of the stream types the handler accepts.
  */
-class Handler final : public core::interface::IHandler {
+template <Serializer... Serializers>
+class BasicHandler final : public core::interface::IHandler, public core::interface::IEventSource {
 public:
     /**
-     * @brief Constructs a Binance handler.
+     * @brief Constructs a Binance handler with its own connector.
      *
      * @param ioc Reference to a Boost.Asio io_context for async operations.
+     * @param config Handler configuration, including the served symbol.
+     */
+    BasicHandler(boost::asio::io_context& ioc, const Config& config);
+
+    /**
+     * @brief Constructs a Binance handler on a given connector.
+     *
+     * Handlers sharing a Connector in the combined mode share its connections. Any
+     * other IConnector, e.g. one delivering frames from memory, can stand in for the
+     * network.
+     *
+     * @param connector Connector used for subscriptions.
+     * @param config Handler configuration, including the served symbol.
      */
-    Handler(boost::asio::io_context& ioc);
+    BasicHandler(std::shared_ptr<core::interface::IConnector> connector, const Config& config);
 
     /**
      * @brief Adds a new subscription target for a specific event type.
      *
      * @param evt The event type (e.g., bid, ask, trade).
      * @param target The subscription target, e.g., trading symbol or channel.
+     * @throws std::invalid_argument if none of the serializers parses the event type.
      */
     void AddTarget(EventType evt, std::string_view target);
 
@@ -50,6 +95,48 @@ public:
      */
     void Init() override;
 
+    /**
+     * @brief Parses at most one pending frame of every connection.
+     *
+     * Overrides IHandler::Parse(). Called from the parse thread.
+     *
+     * @return True if any frame was parsed; otherwise false.
+     */
+    bool Parse() override;
+
+    /**
+     * @brief Returns the events of the oldest parsed frame.
+     *
+     * Overrides IEventSource::Front(). Called from the consumer thread.
+     */
+    inline const core::interface::EventBatch* Front() noexcept override {
+        return m_batches.Front();
+    }
+
+    /**
+     * @brief Releases the batch returned by Front().
+     *
+     * Overrides IEventSource::Pop(). Called from the consumer thread.
+     */
+    inline void Pop() noexcept override { m_batches.Pop(); }
+
+    /**
+     * @brief Counters of the handler stages.
+     */
+    struct Stats {
+        uint64_t framesParsed;  /**< Frames taken by the parse stage. */
+        uint64_t eventsParsed;  /**< Normalized events produced by the parse stage. */
+        uint64_t framesDropped; /**< Frames dropped on a full frame ring. */
+        uint64_t errors;        /**< Receive and parse errors. */
+    };
+
+    /**
+     * @brief Returns the current counters.
+     *
+     * May be called from any thread once all targets are added.
+     */
+    Stats GetStats() const noexcept;
+
 private:
     /**
      * @brief Callback invoked when a connection succeeds.
@@ -59,7 +146,9 @@ private:
     void OnConnectionSuccessed(size_t idx);
 
     /**
-     * @brief Callback invoked when a connection fails.
+     * @brief Callback invoked when a connection attempt fails.
+     *
+     * Only logs; the session retries by itself.
      *
      * @param idx Index of the parser/connection.
      * @param ec Error code indicating the failure reason.
@@ -69,10 +158,14 @@ private:
     /**
      * @brief Callback invoked when data is successfully received.
      *
+     * Copies the frame into the frame ring of the connection. Frames dropped on a full
+     * ring are counted in GetStats() and logged once per dropLogInterval.
+     *
      * @param idx Index of the parser/connection.
      * @param data Span containing the received byte data.
+     * @param recvTsNs Receive time of the data in nanoseconds since the epoch.
      */
-    void OnReceiveSuccessed(size_t idx, std::span<std::byte> data);
+    void OnReceiveSuccessed(size_t idx, std::span<std::byte> data, uint64_t recvTsNs);
 
     /**
      * @brief Callback invoked when data reception fails.
@@ -98,48 +191,53 @@ private:
     void OnStop(size_t idx);
 
 private:
-    /**
-     * @brief Checks whether the Smart Order Router (SOR) should be updated.
-     *
-     * Uses a 200ms minimum interval between updates.
-     *
-     * @return True if SOR should be updated; false otherwise.
-     */
-    inline bool ShouldUpdateSor() noexcept {
-        using namespace std::chrono_literals;
-        return std::chrono::steady_clock::now() - m_sorLastUpdate >= 200ms;
-    }
+    static constexpr uint64_t dropLogInterval = 1024; /**< Dropped frames per warning. */
 
     /**
-     * @brief Updates the timestamp for the last SOR update.
+     * @brief A raw frame copied out of the network buffer.
      */
-    inline void SorUpdated() noexcept { m_sorLastUpdate = std::chrono::steady_clock::now(); }
-
-private:
-    using notifier_t = std::unique_ptr<core::interface::INotifier>; /**< Notifier pointer type. */
-    using serializer_t =
-        std::unique_ptr<core::interface::ISerializer>; /**< Serializer pointer type. */
+    struct Frame {
+        std::vector<std::byte> bytes; /**< Frame data followed by receivePadding bytes. */
+        std::size_t size = 0;         /**< Frame size without the padding. */
+        uint32_t connection = 0;      /**< Generation of the connection it arrived on. */
+        uint64_t recvTsNs = 0;        /**< Receive time in nanoseconds since the epoch. */
+    };
 
     /**
      * @brief Parser structure holding subscription, notifier, and serializer info.
      */
     struct Parser {
-        std::string_view target; /**< Subscription target (symbol or channel). */
-        notifier_t notifier;     /**< Associated notifier for this parser. */
-        serializer_t serializer; /**< Associated serializer for this parser. */
-        uint16_t errors;         /**< Simple error statistic counter. */
+        template <typename T>
+        Parser(std::string_view target, std::in_place_type_t<T> type,
+               const common::exchange::SymbolParams& symbol, std::size_t queueSize)
+            : target(target), serializer(type, symbol), frames(queueSize) {}
+
+        std::string_view target;                   /**< Subscription target. */
+        BaseNotifier notifier;                     /**< Associated notifier for this parser. */
+        std::variant<Serializers...> serializer;   /**< Associated serializer for this parser. */
+        core::concurrency::SpscRing<Frame> frames; /**< Received frames (network → parse). */
+        std::atomic<uint16_t> errors{0};           /**< Simple error statistic counter. */
+        std::atomic<uint64_t> dropped{0};          /**< Frames dropped on a full ring. */
+        uint32_t connections = 0;                  /**< Connections made (network thread). */
+        std::optional<uint32_t> parsed;            /**< Connection being parsed (parse thread). */
     };
 
-    std::vector<Parser> m_parsers;                        /**< List of active parsers. */
-    Connector m_connector;                                /**< Binance connector instance. */
-    std::vector<common::event::NormalizedEvent> m_events; /**< Collected normalized events. */
-    std::vector<core::algorithm::VenueData>
-        m_venueEvents;                                 /**< Venue-specific events for SOR/VWAP. */
-    core::algorithm::VWAP m_vwap;                      /**< VWAP calculator. */
-    core::algorithm::AlmgrenChrissTracker m_acTracker; /**< Almgren–Chriss model tracker. */
-
-    std::chrono::steady_clock::time_point m_sorLastUpdate; /**< Timestamp of last SOR update. */
-    core::algorithm::SOR m_sor;                            /**< Smart Order Router instance. */
+    common::exchange::SymbolParams m_symbol;              /**< Symbol served by the handler. */
+    std::size_t m_frameQueueSize;                         /**< Size of every frame ring. */
+    std::deque<Parser> m_parsers;                         /**< List of active parsers. */
+    core::concurrency::SpscRing<core::interface::EventBatch>
+        m_batches;                               /**< Parsed frames (parse → consumer). */
+    std::atomic<uint64_t> m_framesParsed{0};     /**< Frames parsed (parse thread). */
+    std::atomic<uint64_t> m_eventsParsed{0};     /**< Events parsed (parse thread). */
+    std::shared_ptr<core::interface::IConnector>
+        m_connector;                             /**< Connector of the targets. */
 };
 
+/**
+ * @brief Handler of Binance depth and trade streams.
+ */
+using Handler = BasicHandler<DepthSerializer, TradeSerializer>;
+
+extern template class BasicHandler<DepthSerializer, TradeSerializer>;
+
 }  // namespace exchange::binance
@@ -8,8 +8,6 @@
 #include "serializer.hpp"
 
 namespace exchange::binance {
-enum class EventType { Depth, Trade };
-
 using namespace std::string_view_literals;
 
 static constexpr std::string_view host = "data-stream.binance.vision"sv;
@@ -18,4 +16,7 @@ static constexpr std::string_view venue = "binance";
 
 static constexpr common::exchange::ExchangeParams params{
     .takerFee = 0.0004, .lambda = 0.1, .targetAmount = 2.0};
+
+static constexpr common::exchange::SymbolParams ethusdt{
+    .name = "ethusdt", .priceDecimals = 2, .sizeDecimals = 4};
 }  // namespace exchange::binance
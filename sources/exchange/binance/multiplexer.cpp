@@ -0,0 +1,161 @@
+#include "multiplexer.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <core/log/log.hpp>
+
+namespace exchange::binance {
+namespace {
+constexpr std::string_view streamPrefix = R"({"stream":")";
+constexpr std::string_view dataPrefix = R"(","data":)";
+constexpr std::string_view idKey = R"("id":)";
+constexpr std::string_view resultKey = R"("result":)";
+constexpr std::string_view targetPrefix = "/stream?streams=";
+
+inline std::string_view AsText(std::span<const std::byte> frame) noexcept {
+    return {reinterpret_cast<const char*>(frame.data()), frame.size()};
+}
+}  // namespace
+
+Multiplexer::Multiplexer() : m_target(targetPrefix) {
+    using core::interface::INotifier;
+
+    OnConnectionSuccessed = [this] { Broadcast(&INotifier::OnConnectionSuccessed); };
+    OnConnectionFailed = [this](core::error_handling::ErrorCode ec) {
+        Broadcast(&INotifier::OnConnectionFailed, ec);
+        Closed();
+    };
+    OnReceiveSuccessed = [this](std::span<std::byte> frame, uint64_t recvTsNs) {
+        Route(frame, recvTsNs);
+    };
+    OnReceiveFailed = [this](core::error_handling::ErrorCode ec) {
+        Broadcast(&INotifier::OnReceiveFailed, ec);
+        // an oversized frame is skipped, any other receive error closes the connection
+        if (ec != core::error_handling::ErrorCode::eMsgTooBig) {
+            Closed();
+        }
+    };
+    OnStopRequested = [this] {
+        return std::ranges::all_of(
+            m_streams, [](const Stream& stream) { return stream.notifier->OnStopRequested(); });
+    };
+    OnStop = [this] {
+        Broadcast(&INotifier::OnStop);
+        Closed();
+    };
+}
+
+void Multiplexer::Add(std::string_view stream, core::interface::INotifier* notifier) {
+    if (!m_routes.emplace(stream, notifier).second) {
+        return;
+    }
+    m_streams.emplace_back(std::string{stream}, notifier);
+    UpdateTarget();
+}
+
+bool Multiplexer::Remove(std::string_view stream) {
+    const auto it = m_routes.find(stream);
+    if (it == m_routes.end()) {
+        return false;
+    }
+    m_routes.erase(it);
+    std::erase_if(m_streams, [stream](const Stream& s) { return s.name == stream; });
+    UpdateTarget();
+    return true;
+}
+
+bool Multiplexer::Split(std::span<std::byte> frame, std::string_view& stream,
+                        std::span<std::byte>& data) noexcept {
+    const auto text = AsText(frame);
+    if (!text.starts_with(streamPrefix)) {
+        return false;
+    }
+
+    const auto nameEnd = text.find('"', streamPrefix.size());
+    if (nameEnd == std::string_view::npos ||
+        text.compare(nameEnd, dataPrefix.size(), dataPrefix) != 0) {
+        return false;
+    }
+
+    const auto dataStart = nameEnd + dataPrefix.size();
+    const auto dataEnd = text.find_last_of('}');
+    if (dataEnd == std::string_view::npos || dataEnd <= dataStart) {
+        return false;
+    }
+
+    stream = text.substr(streamPrefix.size(), nameEnd - streamPrefix.size());
+    data = frame.subspan(dataStart, dataEnd - dataStart);
+    return true;
+}
+
+bool Multiplexer::ParseResponse(std::span<const std::byte> frame, uint64_t& id,
+                                bool& accepted) noexcept {
+    const auto text = AsText(frame);
+    auto pos = text.rfind(idKey);
+    if (pos == std::string_view::npos) {
+        return false;
+    }
+
+    pos = text.find_first_not_of(' ', pos + idKey.size());
+    if (pos == std::string_view::npos) {
+        return false;
+    }
+    const auto* const end = text.data() + text.size();
+    if (std::from_chars(text.data() + pos, end, id).ec != std::errc{}) {
+        return false;
+    }
+
+    accepted = text.find(resultKey) != std::string_view::npos;
+    return true;
+}
+
+void Multiplexer::Route(std::span<std::byte> frame, uint64_t recvTsNs) {
+    std::string_view stream;
+    std::span<std::byte> data;
+    if (!Split(frame, stream, data)) [[unlikely]] {
+        uint64_t id;
+        bool accepted;
+        if (ParseResponse(frame, id, accepted)) {
+            LOG(info, "Got response to request {} on {}: {}", id, m_target, AsText(frame));
+            if (m_onResponse) {
+                m_onResponse(id, accepted);
+            }
+        } else {
+            LOG(warn, "Skipped unexpected frame on {}: {}", m_target, AsText(frame));
+        }
+        return;
+    }
+
+    const auto it = m_routes.find(stream);
+    if (it == m_routes.end()) [[unlikely]] {
+        ++m_unrouted;
+        LOG(warn, "Got frame of unknown stream {}. Unrouted frames: {}", stream, m_unrouted);
+        return;
+    }
+
+    it->second->OnReceiveSuccessed(data, recvTsNs);
+}
+
+void Multiplexer::UpdateTarget() {
+    m_target = targetPrefix;
+    for (const auto& stream : m_streams) {
+        if (&stream != &m_streams.front()) {
+            m_target += '/';
+        }
+        m_target += stream.name;
+    }
+}
+
+void Multiplexer::Closed() const {
+    if (m_onClosed) {
+        m_onClosed();
+    }
+}
+
+template <typename Callback, typename... Args>
+void Multiplexer::Broadcast(Callback core::interface::INotifier::*callback, Args... args) const {
+    for (const auto& stream : m_streams) {
+        (stream.notifier->*callback)(args...);
+    }
+}
+}  // namespace exchange::binance
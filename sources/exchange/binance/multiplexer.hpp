@@ -0,0 +1,172 @@
+#pragma once
+
+#include <core/interface/notifier.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace exchange::binance {
+
+/**
+ * @brief Notifier of a combined-stream connection that routes frames to per-stream notifiers.
+ *
+ * Binance combined streams (`/stream?streams=a/b/c`) wrap every payload into an
+ * envelope `{"stream":"<name>","data":<payload>}`. The multiplexer reads the
+ * stream name from the envelope prefix without a JSON parser and hands the
+ * payload span, in place, to the notifier registered for that stream. The payload
+ * is followed by the rest of the frame, so the receive padding guarantee holds.
+ * Connection events are forwarded to every registered notifier; the connection is
+ * stopped once all of them request a stop.
+ *
+ * Frames that are not stream data are responses to SUBSCRIBE/UNSUBSCRIBE requests
+ * (`{"result":null,"id":1}`), which are passed to the response callback. Requests
+ * still waiting for a response are lost with the connection, which is reported to
+ * the closed callback.
+ */
+class Multiplexer final : public core::interface::INotifier {
+public:
+    /**
+     * @brief Callback invoked for a request response.
+     *
+     * @param id Request id.
+     * @param accepted True if the request succeeded; otherwise false.
+     */
+    using ResponseCallback = std::function<void(uint64_t id, bool accepted)>;
+
+    /**
+     * @brief Callback invoked when the connection is lost or fails to come up.
+     */
+    using ClosedCallback = std::function<void()>;
+
+    /**
+     * @brief Constructs a multiplexer without streams.
+     */
+    Multiplexer();
+
+    /**
+     * @brief Registers a stream.
+     *
+     * @param stream Stream name, e.g. "ethusdt@trade".
+     * @param notifier Notifier receiving the payloads of the stream.
+     */
+    void Add(std::string_view stream, core::interface::INotifier* notifier);
+
+    /**
+     * @brief Unregisters a stream; frames of the stream are not routed anymore.
+     *
+     * @param stream Stream name.
+     * @return False if the stream is not registered.
+     */
+    bool Remove(std::string_view stream);
+
+    /**
+     * @brief Checks whether a stream is registered.
+     */
+    inline bool Contains(std::string_view stream) const { return m_routes.contains(stream); }
+
+    /**
+     * @brief Returns the number of registered streams.
+     */
+    inline std::size_t Size() const noexcept { return m_streams.size(); }
+
+    /**
+     * @brief Returns the combined-stream target of the registered streams.
+     */
+    inline const std::string& Target() const noexcept { return m_target; }
+
+    /**
+     * @brief Sets the callback invoked for request responses.
+     */
+    inline void SetResponseCallback(ResponseCallback callback) {
+        m_onResponse = std::move(callback);
+    }
+
+    /**
+     * @brief Sets the callback invoked when the connection is lost.
+     */
+    inline void SetClosedCallback(ClosedCallback callback) { m_onClosed = std::move(callback); }
+
+    /**
+     * @brief Splits a combined-stream frame into the stream name and the payload.
+     *
+     * @param frame Received frame.
+     * @param stream Stream name of the frame.
+     * @param data Payload of the frame, a subspan of `frame`.
+     * @return False if the frame is not a combined-stream envelope.
+     */
+    static bool Split(std::span<std::byte> frame, std::string_view& stream,
+                      std::span<std::byte>& data) noexcept;
+
+    /**
+     * @brief Parses a request response (`{"result":null,"id":1}` or an error with an id).
+     *
+     * @param frame Received frame.
+     * @param id Request id of the response.
+     * @param accepted True if the response carries a result, false for an error.
+     * @return False if the frame is not a response.
+     */
+    static bool ParseResponse(std::span<const std::byte> frame, uint64_t& id,
+                              bool& accepted) noexcept;
+
+private:
+    /**
+     * @brief Routes a received frame to the notifier of its stream.
+     *
+     * @param frame Received frame.
+     * @param recvTsNs Receive time of the frame, passed on unchanged.
+     */
+    void Route(std::span<std::byte> frame, uint64_t recvTsNs);
+
+    /**
+     * @brief Rebuilds the combined-stream target from the registered streams.
+     */
+    void UpdateTarget();
+
+    /**
+     * @brief Reports a lost connection to the closed callback.
+     */
+    void Closed() const;
+
+    /**
+     * @brief Forwards a connection event to all registered notifiers.
+     */
+    template <typename Callback, typename... Args>
+    void Broadcast(Callback core::interface::INotifier::*callback, Args... args) const;
+
+private:
+    /**
+     * @brief Transparent string hash for lookups by std::string_view.
+     */
+    struct StringHash {
+        using is_transparent = void; /**< Enables heterogeneous lookup. */
+
+        inline std::size_t operator()(std::string_view str) const noexcept {
+            return std::hash<std::string_view>{}(str);
+        }
+    };
+
+    /**
+     * @brief A registered stream.
+     */
+    struct Stream {
+        std::string name;                     /**< Stream name. */
+        core::interface::INotifier* notifier; /**< Notifier of the stream. */
+    };
+
+    using routes_t = std::unordered_map<std::string, core::interface::INotifier*, StringHash,
+                                        std::equal_to<>>; /**< Stream name to notifier map. */
+
+    routes_t m_routes;             /**< Notifier of every stream. */
+    std::vector<Stream> m_streams; /**< Streams in registration order. */
+    std::string m_target;          /**< Combined-stream target. */
+    ResponseCallback m_onResponse; /**< Callback for request responses. */
+    ClosedCallback m_onClosed;     /**< Callback for a lost connection. */
+    uint64_t m_unrouted = 0;       /**< Frames without a known stream. */
+};
+
+}  // namespace exchange::binance
@@ -1,180 +1,313 @@
 #include "serializer.hpp"
 
-#include <simdjson.h>
-
-#include <charconv>
+#include <algorithm>
+#include <common/decimal/decimal.hpp>
 #include <common/event/normalized_event.hpp>
+#include <common/exchange/registry.hpp>
 #include <core/error_handling/error_handling.hpp>
+#include <core/interface/notifier.hpp>
 #include <core/log/log.hpp>
-#include <stdexcept>
+#include <core/metrics/clock.hpp>
 
 #include "info.hpp"
 
 namespace exchange::binance {
-std::vector<std::span<std::byte>> SplitJsonObjects(std::span<std::byte> buffer) {
-    std::vector<std::span<std::byte>> objects;
-    int depth = 0;
-    size_t start = 0;
+namespace ceh = core::error_handling;
+
+static_assert(core::interface::receivePadding >= simdjson::SIMDJSON_PADDING);
+
+/**
+ * @brief Starts a document stream over all JSON objects of a received frame.
+ *
+ * The frame is followed by `receivePadding` readable bytes (see INotifier), so it is
+ * parsed in place. The batch covers the whole frame, which keeps the stream single-pass.
+ * The parser reallocates whenever the batch size differs from its capacity, so the
+ * batch is never smaller than the capacity: it grows to the largest frame seen so far
+ * and frames of other lengths reuse it.
+ */
+static inline simdjson::error_code IterateFrame(simdjson::ondemand::parser& parser,
+                                                std::span<std::byte> buffer,
+                                                simdjson::ondemand::document_stream& docs) {
+    const auto batchSize = std::max(parser.capacity(), buffer.size());
+    return parser
+        .iterate_many(reinterpret_cast<const char*>(buffer.data()), buffer.size(), batchSize)
+        .get(docs);
+}
 
-    for (size_t i = 0; i < buffer.size(); ++i) {
-        char c = static_cast<char>(buffer[i]);
+/**
+ * @brief Parses a decimal JSON string into a fixed-point integer with the given scale.
+ */
+template <typename T>
+static inline simdjson::error_code ParseDecimal(T&& value, uint8_t decimals, int64_t& out) {
+    std::string_view str;
+    if (auto err = std::forward<T>(value).get_string().get(str); err) [[unlikely]] {
+        return err;
+    }
+    return common::decimal::Parse(str, decimals, out) ? simdjson::SUCCESS
+                                                      : simdjson::NUMBER_ERROR;
+}
 
-        if (c == '{') {
-            if (depth == 0) {
-                start = i;
-            }
-            depth++;
+/**
+ * @brief Maps a simdjson parsing error to the system error code.
+ */
+static inline ceh::ErrorCode ToErrorCode(simdjson::error_code err) {
+    return err == simdjson::NUMBER_ERROR ? ceh::ErrorCode::eInvalidNumber
+                                         : ceh::ErrorCode::eInvalidJson;
+}
+
+using Events = core::interface::ISerializer::Events;
+using common::event::EventColumns;
+using core::metrics::NowUs;
+
+/**
+ * @brief Output adapters, so the same parser fills events or columns.
+ */
+static inline std::size_t Size(const Events& events) {
+    return events.size();
+}
+
+static inline std::size_t Size(const EventColumns& columns) {
+    return columns.Size();
+}
+
+static inline void Append(Events& events, const common::event::NormalizedEvent& e) {
+    events.push_back(e);
+}
+
+static inline void Append(EventColumns& columns, const common::event::NormalizedEvent& e) {
+    columns.Append(e);
+}
+
+static inline void Truncate(Events& events, std::size_t size) {
+    events.resize(size);
+}
+
+static inline void Truncate(EventColumns& columns, std::size_t size) {
+    columns.Truncate(size);
+}
+
+static inline void SetExchangeTs(Events& events, std::size_t first, uint64_t exchangeTsUs) {
+    for (auto i = first; i < events.size(); ++i) {
+        events[i].exchangeTsUs = exchangeTsUs;
+    }
+}
+
+// columns carry no timestamps
+static inline void SetExchangeTs(EventColumns&, std::size_t, uint64_t) {}
+
+/**
+ * @brief Parses one side of a depth snapshot (`[["price","qty"], ...]`) into events.
+ */
+template <typename Out>
+static simdjson::error_code ParseLevels(simdjson::simdjson_result<simdjson::ondemand::value> side,
+                                        common::event::Type type,
+                                        const common::exchange::SymbolParams& symbol,
+                                        common::event::NormalizedEvent& e, Out& out) {
+    simdjson::ondemand::array levels;
+    if (auto err = side.get_array().get(levels); err) [[unlikely]] {
+        return err;
+    }
+
+    e.type = type;
+    e.level = 0;
+    for (auto level : levels) {
+        simdjson::ondemand::array row;
+        if (auto err = level.get_array().get(row); err) [[unlikely]] {
+            return err;
         }
 
-        if (c == '}') {
-            depth--;
-            if (depth == 0) {
-                objects.emplace_back(buffer.subspan(start, i - start + 1));
-            }
+        auto it = row.begin();
+        if (auto err = ParseDecimal(*it, symbol.priceDecimals, e.price); err) [[unlikely]] {
+            return err;
         }
+        ++it;
+        if (auto err = ParseDecimal(*it, symbol.sizeDecimals, e.size); err) [[unlikely]] {
+            return err;
+        }
+
+        Append(out, e);
+        ++e.level;
     }
 
-    return objects;
+    return simdjson::SUCCESS;
+}
+
+/**
+ * @brief Parses an exchange timestamp in milliseconds into microseconds.
+ */
+template <typename T>
+static inline simdjson::error_code ParseTimeMs(T&& value, uint64_t& outUs) {
+    uint64_t ms;
+    if (auto err = std::forward<T>(value).get_uint64().get(ms); err) [[unlikely]] {
+        return err;
+    }
+    outUs = ms * 1000;
+    return simdjson::SUCCESS;
 }
 
-inline uint64_t NowUs() {
-    return std::chrono::duration_cast<std::chrono::microseconds>(
-               std::chrono::system_clock::now().time_since_epoch())
-        .count();
+/**
+ * @brief Drops the events appended for a failed frame and reports the reason.
+ */
+template <typename Out>
+static inline bool Fail(Out& out, std::size_t size, ceh::ErrorCode reason, ceh::ErrorCode& ec) {
+    Truncate(out, size);
+    ec = reason;
+    return false;
 }
 
-void DepthSerializer::Serialize(std::span<std::byte> buffer, OnSuccess OnSuccessed,
-                                OnFail OnFailed) {
+DepthSerializer::DepthSerializer(const common::exchange::SymbolParams& symbol)
+    : m_symbol(symbol),
+      m_venueId(common::exchange::RegisterVenue(venue)),
+      m_symbolId(common::exchange::RegisterSymbol(m_venueId, symbol.name)) {}
+
+bool DepthSerializer::Serialize(std::span<std::byte> buffer, uint64_t recvTsNs, Events& events,
+                                ceh::ErrorCode& ec) {
+    return Parse(buffer, recvTsNs, events, ec);
+}
+
+bool DepthSerializer::Serialize(std::span<std::byte> buffer, uint64_t recvTsNs,
+                                EventColumns& columns, ceh::ErrorCode& ec) {
+    return Parse(buffer, recvTsNs, columns, ec);
+}
+
+template <typename Out>
+bool DepthSerializer::Parse(std::span<std::byte> buffer, uint64_t recvTsNs, Out& out,
+                            ceh::ErrorCode& ec) {
     using event_t = common::event::NormalizedEvent;
-    std::vector<event_t> events;
+    const auto size = Size(out);
     event_t e;
-    e.venue = venue;
+    e.venue = m_venueId;
+    e.symbol = m_symbolId;
+    e.recvTsUs = recvTsNs / 1000;
     e.tsUs = NowUs();
     e.source = common::event::Source::Depth;
 
-    simdjson::ondemand::parser parser;
-    const auto objs = SplitJsonObjects(buffer);
-
-    for (const auto& el : objs) {
-        simdjson::padded_string json(reinterpret_cast<const char*>(el.data()), el.size());
+    simdjson::ondemand::document_stream docs;
+    if (IterateFrame(m_parser, buffer, docs)) [[unlikely]] {
+        LOG(warn, "Received invalid json");
+        return Fail(out, size, ceh::ErrorCode::eInvalidJson, ec);
+    }
 
-        auto doc = parser.iterate(json);
+    for (auto doc : docs) {
+        const auto first = Size(out);
+        uint64_t curLastUpdate = INVALID_UPDATE_ID;
+        e.exchangeTsUs = 0;
 
-        if (doc.error()) [[unlikely]] {
+        simdjson::ondemand::object obj;
+        if (doc.get_object().get(obj)) [[unlikely]] {
             LOG(warn, "Received invalid json");
-            OnFailed(core::error_handling::ErrorCode::eInvalidJson);
-            return;
+            return Fail(out, size, ceh::ErrorCode::eInvalidJson, ec);
         }
 
-        auto obj = doc.get_object();
+        simdjson::error_code err = simdjson::SUCCESS;
+        for (auto field : obj) {
+            std::string_view key;
+            if (err = field.escaped_key().get(key); err) [[unlikely]] {
+                break;
+            }
+
+            if (key == "lastUpdateId") {
+                err = field.value().get_uint64().get(curLastUpdate);
+            } else if (key == "E") {
+                err = ParseTimeMs(field.value(), e.exchangeTsUs);
+            } else if (key == "bids") {
+                err = ParseLevels(field.value(), common::event::Type::Bid, m_symbol, e, out);
+            } else if (key == "asks") {
+                err = ParseLevels(field.value(), common::event::Type::Ask, m_symbol, e, out);
+            }
+            if (err) [[unlikely]] {
+                break;
+            }
+        }
+        if (err) [[unlikely]] {
+            LOG(warn, "Received invalid depth: {}", simdjson::error_message(err));
+            return Fail(out, size, ToErrorCode(err), ec);
+        }
+        if (curLastUpdate == INVALID_UPDATE_ID) [[unlikely]] {
+            LOG(warn, "Received depth without lastUpdateId");
+            return Fail(out, size, ceh::ErrorCode::eInvalidJson, ec);
+        }
 
-        uint64_t curLastUpdate = obj["lastUpdateId"].get_uint64().value();
         if (m_lastUpdateId == INVALID_UPDATE_ID) {
             m_lastUpdateId = curLastUpdate;
         } else if (m_lastUpdateId != curLastUpdate) {
+            ceh::ErrorCode reason;
             if (m_lastUpdateId > curLastUpdate) {
                 LOG(warn, "Received too old data. Expected: {}, got: {}", m_lastUpdateId,
                     curLastUpdate);
-                OnFailed(core::error_handling::ErrorCode::eDataDuplicate);
+                reason = ceh::ErrorCode::eDataDuplicate;
             } else {
                 LOG(warn, "Received too new data. Expected: {}, got: {}", m_lastUpdateId,
                     curLastUpdate);
-                OnFailed(core::error_handling::ErrorCode::eDataGap);
+                reason = ceh::ErrorCode::eDataGap;
             }
             m_lastUpdateId = INVALID_UPDATE_ID;
-            return;
+            return Fail(out, size, reason, ec);
         }
 
-        uint16_t lvl = 0;
-        for (auto bids = obj["bids"].get_array().value(); auto&& b : bids) {
-            auto row = b.get_array().value();
-            auto it = row.begin();
-
-            std::string_view sprice = (*it).get_string().value();
-            float price;
-            std::from_chars(sprice.data(), sprice.data() + sprice.size(), price);
-            ++it;
-
-            std::string_view ssize = (*it).get_string().value();
-            float size;
-            std::from_chars(ssize.data(), ssize.data() + ssize.size(), size);
-
-            e.type = common::event::Type::Bid;
-            e.price = price;
-            e.size = size;
-            e.level = lvl++;
-
-            events.push_back(e);
-        }
-
-        lvl = 0;
-        for (auto asks = obj["asks"].get_array().value(); auto&& a : asks) {
-            auto row = a.get_array().value();
-            auto it = row.begin();
-
-            std::string_view sprice = (*it).get_string().value();
-            float price;
-            std::from_chars(sprice.data(), sprice.data() + sprice.size(), price);
-            ++it;
-
-            std::string_view ssize = (*it).get_string().value();
-            float size;
-            std::from_chars(ssize.data(), ssize.data() + ssize.size(), size);
+        // the event time may follow the levels
+        SetExchangeTs(out, first, e.exchangeTsUs);
+        ++m_lastUpdateId;
+    }
 
-            e.type = common::event::Type::Ask;
-            e.price = price;
-            e.size = size;
-            e.level = lvl++;
+    return true;
+}
 
-            events.push_back(e);
-        }
+TradeSerializer::TradeSerializer(const common::exchange::SymbolParams& symbol)
+    : m_symbol(symbol),
+      m_venueId(common::exchange::RegisterVenue(venue)),
+      m_symbolId(common::exchange::RegisterSymbol(m_venueId, symbol.name)) {}
 
-        ++m_lastUpdateId;
-    }
+bool TradeSerializer::Serialize(std::span<std::byte> buffer, uint64_t recvTsNs, Events& events,
+                                ceh::ErrorCode& ec) {
+    return Parse(buffer, recvTsNs, events, ec);
+}
 
-    OnSuccessed(events);
+bool TradeSerializer::Serialize(std::span<std::byte> buffer, uint64_t recvTsNs,
+                                EventColumns& columns, ceh::ErrorCode& ec) {
+    return Parse(buffer, recvTsNs, columns, ec);
 }
 
-void TradeSerializer::Serialize(std::span<std::byte> buffer, OnSuccess OnSuccessed,
-                                OnFail OnFailed) {
+template <typename Out>
+bool TradeSerializer::Parse(std::span<std::byte> buffer, uint64_t recvTsNs, Out& out,
+                            ceh::ErrorCode& ec) {
     using event_t = common::event::NormalizedEvent;
-    std::vector<event_t> events;
+    const auto size = Size(out);
     event_t e;
-    e.venue = venue;
+    e.venue = m_venueId;
+    e.symbol = m_symbolId;
+    e.recvTsUs = recvTsNs / 1000;
     e.tsUs = NowUs();
     e.source = common::event::Source::Trade;
     e.type = common::event::Type::Unspecified;
     e.level = 0;
 
-    simdjson::ondemand::parser parser;
-    const auto objs = SplitJsonObjects(buffer);
-
-    for (const auto& el : objs) {
-        simdjson::padded_string json(reinterpret_cast<const char*>(el.data()), el.size());
-
-        auto doc = parser.iterate(json);
+    simdjson::ondemand::document_stream docs;
+    if (IterateFrame(m_parser, buffer, docs)) [[unlikely]] {
+        LOG(warn, "Received invalid json");
+        return Fail(out, size, ceh::ErrorCode::eInvalidJson, ec);
+    }
 
-        if (doc.error()) [[unlikely]] {
-            LOG(warn, "Received invalid json");
-            OnFailed(core::error_handling::ErrorCode::eInvalidJson);
-            return;
+    for (auto doc : docs) {
+        simdjson::ondemand::object obj;
+        auto err = doc.get_object().get(obj);
+        if (!err) {
+            err = ParseTimeMs(obj["E"], e.exchangeTsUs);
+        }
+        if (!err) {
+            err = ParseDecimal(obj["p"], m_symbol.priceDecimals, e.price);
+        }
+        if (!err) {
+            err = ParseDecimal(obj["q"], m_symbol.sizeDecimals, e.size);
+        }
+        if (err) [[unlikely]] {
+            LOG(warn, "Received invalid trade: {}", simdjson::error_message(err));
+            return Fail(out, size, ToErrorCode(err), ec);
         }
 
-        auto obj = doc.get_object();
-
-        std::string_view sprice = obj["p"].get_string().value();
-        float price;
-        std::from_chars(sprice.data(), sprice.data() + sprice.size(), price);
-
-        std::string_view ssize = obj["q"].get_string().value();
-        float size;
-        std::from_chars(ssize.data(), ssize.data() + ssize.size(), size);
-
-        e.price = price;
-        e.size = size;
-        events.push_back(e);
+        Append(out, e);
     }
 
-    OnSuccessed(events);
+    return true;
 }
 }  // namespace exchange::binance
@@ -1,46 +1,160 @@
 #pragma once
 
+#include <simdjson.h>
+
+#include <common/event/event_columns.hpp>
 #include <common/event/normalized_event.hpp>
+#include <common/exchange/exchange_params.hpp>
+#include <common/exchange/registry.hpp>
+#include <concepts>
+#include <core/error_handling/error_handling.hpp>
 #include <core/interface/serializer.hpp>
+#include <cstdint>
 #include <span>
-#include <vector>
+#include <type_traits>
 
 namespace exchange::binance {
+enum class EventType { Depth, Trade };
 
 /**
  * @brief Serializer for Binance order book (depth) events.
  *
  * Parses raw byte data from the Binance depth feed and converts it
- * into normalized market events. Invokes callbacks on success or failure.
+ * into normalized market events appended to a caller-owned buffer, either
+ * as events or as columns (see EventColumns) for vectorized aggregation.
+ * Concatenated objects are parsed as a simdjson document stream with a
+ * parser that is reused across messages. Fields are read in a single pass
+ * in any order; the event time `E` is optional as partial book depth
+ * snapshots do not carry it.
+ *
+ * The class is final, so callers that hold the concrete type call Serialize()
+ * without a virtual dispatch.
  */
 class DepthSerializer final : public core::interface::ISerializer {
 public:
+    static constexpr EventType type = EventType::Depth; /**< Stream type it parses. */
+
+    /**
+     * @brief Constructs a depth serializer.
+     *
+     * Registers the venue and the symbol, whose ids are stamped on every event.
+     *
+     * @param symbol Symbol parameters defining the fixed-point scale of prices and sizes.
+     */
+    explicit DepthSerializer(const common::exchange::SymbolParams& symbol);
+
     /**
      * @brief Deserializes raw depth data.
      *
      * @param buffer Raw byte data from the Binance depth feed.
-     * @param OnSuccessed Callback invoked with deserialized events on success.
-     * @param OnFailed Callback invoked with an error code on failure.
+     * @param recvTsNs Receive time of the data in nanoseconds since the epoch.
+     * @param events Buffer the deserialized events are appended to.
+     * @param ec Set to the reason of the failure.
+     * @return True on success, false otherwise.
      */
-    void Serialize(std::span<std::byte> buffer, OnSuccess OnSuccessed, OnFail OnFailed) override;
+    bool Serialize(std::span<std::byte> buffer, uint64_t recvTsNs, Events& events,
+                   core::error_handling::ErrorCode& ec) override;
+
+    /**
+     * @brief Deserializes raw depth data into columns.
+     *
+     * Not part of ISerializer: only callers that hold the concrete type and aggregate
+     * over a batch (see EventColumns) use it.
+     *
+     * @param buffer Raw byte data from the Binance depth feed.
+     * @param recvTsNs Receive time of the data in nanoseconds since the epoch.
+     * @param columns Columns the deserialized events are appended to.
+     * @param ec Set to the reason of the failure.
+     * @return True on success, false otherwise.
+     */
+    bool Serialize(std::span<std::byte> buffer, uint64_t recvTsNs,
+                   common::event::EventColumns& columns, core::error_handling::ErrorCode& ec);
+
+private:
+    /**
+     * @brief Parses a frame into events or columns.
+     */
+    template <typename Out>
+    bool Parse(std::span<std::byte> buffer, uint64_t recvTsNs, Out& out,
+               core::error_handling::ErrorCode& ec);
+
+private:
+    common::exchange::SymbolParams m_symbol; /**< Symbol parameters (fixed-point scale). */
+    common::exchange::VenueId m_venueId;     /**< Registered id of the venue. */
+    common::exchange::SymbolId m_symbolId;   /**< Registered id of the symbol. */
+    simdjson::ondemand::parser m_parser;     /**< Reusable parser, its capacity only grows. */
 };
 
 /**
  * @brief Serializer for Binance trade events.
  *
  * Parses raw byte data from the Binance trade feed and converts it
- * into normalized market events. Invokes callbacks on success or failure.
+ * into normalized market events appended to a caller-owned buffer.
+ * Concatenated objects are parsed as a simdjson document stream with a
+ * parser that is reused across messages. The event time `E` is required.
  */
 class TradeSerializer final : public core::interface::ISerializer {
 public:
+    static constexpr EventType type = EventType::Trade; /**< Stream type it parses. */
+
+    /**
+     * @brief Constructs a trade serializer.
+     *
+     * Registers the venue and the symbol, whose ids are stamped on every event.
+     *
+     * @param symbol Symbol parameters defining the fixed-point scale of prices and sizes.
+     */
+    explicit TradeSerializer(const common::exchange::SymbolParams& symbol);
+
     /**
      * @brief Deserializes raw trade data.
      *
      * @param buffer Raw byte data from the Binance trade feed.
-     * @param OnSuccessed Callback invoked with deserialized events on success.
-     * @param OnFailed Callback invoked with an error code on failure.
+     * @param recvTsNs Receive time of the data in nanoseconds since the epoch.
+     * @param events Buffer the deserialized events are appended to.
+     * @param ec Set to the reason of the failure.
+     * @return True on success, false otherwise.
      */
-    void Serialize(std::span<std::byte> buffer, OnSuccess OnSuccessed, OnFail OnFailed) override;
+    bool Serialize(std::span<std::byte> buffer, uint64_t recvTsNs, Events& events,
+                   core::error_handling::ErrorCode& ec) override;
+
+    /**
+     * @brief Deserializes raw trade data into columns.
+     *
+     * Not part of ISerializer, like the DepthSerializer overload.
+     *
+     * @param buffer Raw byte data from the Binance trade feed.
+     * @param recvTsNs Receive time of the data in nanoseconds since the epoch.
+     * @param columns Columns the deserialized events are appended to.
+     * @param ec Set to the reason of the failure.
+     * @return True on success, false otherwise.
+     */
+    bool Serialize(std::span<std::byte> buffer, uint64_t recvTsNs,
+                   common::event::EventColumns& columns, core::error_handling::ErrorCode& ec);
+
+private:
+    /**
+     * @brief Parses a frame into events or columns.
+     */
+    template <typename Out>
+    bool Parse(std::span<std::byte> buffer, uint64_t recvTsNs, Out& out,
+               core::error_handling::ErrorCode& ec);
+
+private:
+    common::exchange::SymbolParams m_symbol; /**< Symbol parameters (fixed-point scale). */
+    common::exchange::VenueId m_venueId;     /**< Registered id of the venue. */
+    common::exchange::SymbolId m_symbolId;   /**< Registered id of the symbol. */
+    simdjson::ondemand::parser m_parser;     /**< Reusable parser, its capacity only grows. */
 };
 
+/**
+ * @brief A Binance serializer that a handler can dispatch to statically.
+ *
+ * It parses one stream type and is built from the symbol parameters.
+ */
+template <typename T>
+concept Serializer = std::derived_from<T, core::interface::ISerializer> &&
+                     std::constructible_from<T, const common::exchange::SymbolParams&> &&
+                     std::same_as<std::remove_cv_t<decltype(T::type)>, EventType>;
+
 }  // namespace exchange::binance
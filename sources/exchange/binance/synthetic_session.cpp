@@ -0,0 +1,134 @@
+#include "synthetic_session.hpp"
+
+#include <atomic>
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <chrono>
+#include <core/error_handling/error_handling.hpp>
+#include <core/log/log.hpp>
+#include <core/metrics/clock.hpp>
+#include <optional>
+#include <span>
+
+namespace exchange::binance {
+
+namespace ceh = core::error_handling;
+namespace net = boost::asio;
+
+class SyntheticSession::Impl final : public std::enable_shared_from_this<Impl> {
+public:
+    Impl(net::io_context& ioc, const GeneratorConfig& config)
+        : m_timer(net::make_strand(ioc)), m_config(config) {}
+
+    void Start(std::string_view target, core::interface::INotifier* notifier) {
+        m_notifier = notifier;
+
+        try {
+            m_generator.emplace(m_config, target);
+        } catch (const std::exception& e) {
+            LOG(err, "Failed to generate target {}: {}", target, e.what());
+            m_notifier->OnConnectionFailed(ceh::ErrorCode::eConnectionFailed);
+            return;
+        }
+
+        net::post(m_timer.get_executor(),
+                  [self = shared_from_this(), target = std::string{target}] {
+                      LOG(info, "Generating {}", target);
+                      self->m_notifier->OnConnectionSuccessed();
+                      self->m_due = std::chrono::steady_clock::now();
+                      self->GenerateNext();
+                  });
+    }
+
+    void SetTarget(std::string_view target) {
+        net::post(m_timer.get_executor(),
+                  [self = shared_from_this(), target = std::string{target}] {
+                      if (!self->m_generator) {
+                          return;
+                      }
+                      try {
+                          self->m_generator->SetTarget(target);
+                      } catch (const std::exception& e) {
+                          LOG(err, "Failed to generate target {}: {}", target, e.what());
+                      }
+                  });
+    }
+
+    inline void Close() noexcept {
+        m_closed = true;
+        m_timer.cancel();
+    }
+
+private:
+    void GenerateNext() {
+        if (m_closed) {
+            return;
+        }
+
+        // due times are absolute, so timer latency does not lower the rate
+        m_due += m_generator->Next(m_frame);
+        if (m_due <= std::chrono::steady_clock::now()) {
+            net::post(m_timer.get_executor(), [self = shared_from_this()] { self->Deliver(); });
+            return;
+        }
+
+        m_timer.expires_at(m_due);
+        m_timer.async_wait([self = shared_from_this()](boost::system::error_code ec) {
+            if (ec) {
+                return;
+            }
+            self->Deliver();
+        });
+    }
+
+    void Deliver() {
+        if (m_closed) {
+            return;
+        }
+
+        if (m_notifier->OnStopRequested()) {
+            m_notifier->OnStop();
+            return;
+        }
+
+        if (!m_frame.empty()) {
+            const auto size = m_frame.size();
+            m_frame.resize(size + core::interface::receivePadding);
+            m_notifier->OnReceiveSuccessed(std::as_writable_bytes(std::span{m_frame.data(), size}),
+                                           core::metrics::NowNs());
+        }
+        GenerateNext();
+    }
+
+private:
+    net::steady_timer m_timer;                       /**< Pacing timer, bound to a strand. */
+    GeneratorConfig m_config;                        /**< Generator settings. */
+    std::optional<Generator> m_generator;            /**< Generator of the target streams. */
+    std::string m_frame;                             /**< Message pending delivery, padded. */
+    std::chrono::steady_clock::time_point m_due;     /**< Delivery time of the message. */
+    std::atomic<bool> m_closed{false};               /**< Set once the session is closed. */
+    core::interface::INotifier* m_notifier{nullptr}; /**< Notifier for event callbacks. */
+};
+
+SyntheticSession::SyntheticSession(boost::asio::io_context& ioc, const GeneratorConfig& config)
+    : m_impl{std::make_shared<Impl>(ioc, config)} {}
+
+void SyntheticSession::Connect(std::string_view, std::string_view target, uint16_t,
+                               core::interface::INotifier* notifier) noexcept {
+    m_impl->Start(target, notifier);
+}
+
+void SyntheticSession::Send(std::string message) {
+    LOG(debug, "Dropped message sent to a synthetic session: {}", message);
+}
+
+void SyntheticSession::SetTarget(std::string_view target) {
+    m_impl->SetTarget(target);
+}
+
+SyntheticSession::~SyntheticSession() {
+    m_impl->Close();
+}
+
+}  // namespace exchange::binance
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <boost/asio/io_context.hpp>
+#include <core/interface/session.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "generator.hpp"
+
+namespace exchange::binance {
+
+/**
+ * @brief Session that generates synthetic market data instead of connecting to the network.
+ *
+ * The SyntheticSession implements ISession on top of a Generator serving the
+ * streams of the connected target. Messages are delivered through
+ * INotifier::OnReceiveSuccessed on the given io_context at the generated times;
+ * a consumer that falls behind gets the late messages back to back. SUBSCRIBE and
+ * UNSUBSCRIBE requests are not answered, SetTarget() switches the generated streams
+ * right away instead.
+ */
+class SyntheticSession final : public core::interface::ISession {
+public:
+    /**
+     * @brief Constructs a synthetic session.
+     *
+     * @param ioc Reference to a Boost.Asio io_context the messages are delivered on.
+     * @param config Generator settings.
+     */
+    SyntheticSession(boost::asio::io_context& ioc, const GeneratorConfig& config);
+
+    /**
+     * @brief Starts generating the streams of a target.
+     *
+     * Host and port are ignored. A target with streams that cannot be generated is
+     * reported via OnConnectionFailed.
+     *
+     * @param source Ignored.
+     * @param target Binance target path.
+     * @param port Ignored.
+     * @param notifier Pointer to an INotifier instance for event callbacks.
+     */
+    void Connect(std::string_view source, std::string_view target, uint16_t port,
+                 core::interface::INotifier* notifier) noexcept override;
+
+    /**
+     * @brief Drops the message; requests are not answered.
+     *
+     * @param message Ignored.
+     */
+    void Send(std::string message) override;
+
+    /**
+     * @brief Switches the generated streams to the ones of a target.
+     *
+     * @param target Binance target path.
+     */
+    void SetTarget(std::string_view target) override;
+
+    /**
+     * @brief Destructor. Stops generating.
+     */
+    ~SyntheticSession();
+
+private:
+    /**
+     * @brief Private implementation (PIMPL) to hide internal details.
+     */
+    class Impl;
+
+    std::shared_ptr<Impl> m_impl; /**< Pointer to the implementation details. */
+};
+
+}  // namespace exchange::binance
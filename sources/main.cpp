@@ -1,28 +1,169 @@
+#include <chrono>
 #include <core/log/log.hpp>
+#include <core/metrics/latency.hpp>
+#include <cstdint>
+#include <engine/event_bus.hpp>
 #include <engine/pipeline.hpp>
 #include <exchange/binance/handler.hpp>
 #include <exchange/binance/info.hpp>
 #include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
 
-int main() {
+struct Args {
+    exchange::binance::Config config;
+    engine::StrategyConfig strategy;
+    engine::EventBus::Options bus;
+    engine::Pipeline::Options pipeline;
+    std::chrono::milliseconds latencyReport{0};
+    spdlog::level::level_enum logLevel{spdlog::level::info};
+};
+
+template <typename T, typename Parse>
+static std::vector<T> ParseList(std::string_view list, Parse parse) {
+    std::vector<T> values;
+    while (!list.empty()) {
+        const auto comma = list.find(',');
+        values.push_back(parse(std::string{list.substr(0, comma)}));
+        list.remove_prefix(comma == std::string_view::npos ? list.size() : comma + 1);
+    }
+    return values;
+}
+
+static Args ParseArgs(int argc, char* argv[]) {
+    Args args;
+    auto& config = args.config;
+    auto& strategy = args.strategy;
+    auto& pipeline = args.pipeline;
+    config.symbol = exchange::binance::ethusdt;
+    strategy.symbol = exchange::binance::ethusdt;
+    strategy.venue = exchange::binance::venue;
+    strategy.params = exchange::binance::params;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--record" && i + 1 < argc) {
+            config.captureDir = argv[++i];
+        } else if (arg == "--replay" && i + 1 < argc) {
+            config.replayDir = argv[++i];
+        } else if (arg == "--fast") {
+            config.replayPace = network::capture::Pace::Fast;
+        } else if (arg == "--synthetic" && i + 1 < argc) {
+            config.synthetic.emplace().rate = std::stod(argv[++i]);
+            config.synthetic->priceDecimals = config.symbol.priceDecimals;
+            config.synthetic->sizeDecimals = config.symbol.sizeDecimals;
+        } else if (arg == "--endpoint" && i + 1 < argc) {
+            const std::string_view endpoint = argv[++i];
+            const auto colon = endpoint.rfind(':');
+            config.host = endpoint.substr(0, colon);
+            if (colon != std::string_view::npos) {
+                config.port =
+                    static_cast<uint16_t>(std::stoul(std::string{endpoint.substr(colon + 1)}));
+            }
+        } else if (arg == "--vwap-bands" && i + 1 < argc) {
+            strategy.vwapBands =
+                ParseList<float>(argv[++i], [](const std::string& v) { return std::stof(v); });
+        } else if (arg == "--sor-band" && i + 1 < argc) {
+            strategy.sorBand = std::stoul(argv[++i]);
+        } else if (arg == "--ac-batch") {
+            strategy.ac.mode = core::algorithm::ACMode::Batch;
+        } else if (arg == "--ac-window" && i + 1 < argc) {
+            strategy.ac.mode = core::algorithm::ACMode::Window;
+            strategy.ac.windowSize = std::stoul(argv[++i]);
+        } else if (arg == "--ac-window-ms" && i + 1 < argc) {
+            strategy.ac.mode = core::algorithm::ACMode::Window;
+            strategy.ac.windowSpan = std::chrono::milliseconds{std::stol(argv[++i])};
+        } else if (arg == "--ac-half-life-ms" && i + 1 < argc) {
+            strategy.ac.mode = core::algorithm::ACMode::Exponential;
+            strategy.ac.halfLife = std::chrono::milliseconds{std::stol(argv[++i])};
+        } else if (arg == "--reorder-window-us" && i + 1 < argc) {
+            args.bus.reorderWindow = std::chrono::microseconds{std::stol(argv[++i])};
+        } else if (arg == "--combined" && i + 1 < argc) {
+            config.streamsPerConnection = std::stoul(argv[++i]);
+        } else if (arg == "--reconnect-attempts" && i + 1 < argc) {
+            config.reconnect.maxAttempts = std::stoul(argv[++i]);
+        } else if (arg == "--idle-timeout-ms" && i + 1 < argc) {
+            config.reconnect.idleTimeout = std::chrono::milliseconds{std::stol(argv[++i])};
+        } else if (arg == "--latency-report-ms" && i + 1 < argc) {
+            args.latencyReport = std::chrono::milliseconds{std::stol(argv[++i])};
+        } else if (arg == "--log-level" && i + 1 < argc) {
+            args.logLevel = spdlog::level::from_str(argv[++i]);
+        } else if (arg == "--io-threads" && i + 1 < argc) {
+            pipeline.ioThreads = std::stoul(argv[++i]);
+        } else if (arg == "--io-cpus" && i + 1 < argc) {
+            pipeline.ioCpus =
+                ParseList<int>(argv[++i], [](const std::string& v) { return std::stoi(v); });
+        } else if (arg == "--parse-cpu" && i + 1 < argc) {
+            pipeline.parseCpu = std::stoi(argv[++i]);
+        } else if (arg == "--strategy-cpu" && i + 1 < argc) {
+            pipeline.strategyCpu = std::stoi(argv[++i]);
+        } else {
+            throw std::invalid_argument{
+                "Usage: market_demo [--record DIR | --replay DIR [--fast] | --synthetic RATE] "
+                "[--endpoint HOST:PORT] "
+                "[--vwap-bands P1,P2,... [--sor-band IDX]] "
+                "[--ac-batch | --ac-window N [--ac-window-ms MS] | --ac-half-life-ms MS] "
+                "[--reorder-window-us US] "
+                "[--combined STREAMS] [--reconnect-attempts N] [--idle-timeout-ms MS] "
+                "[--io-threads N [--io-cpus C1,C2,...]] [--parse-cpu C] [--strategy-cpu C] "
+                "[--latency-report-ms MS] [--log-level LEVEL]"};
+        }
+    }
+
+    return args;
+}
+
+int main(int argc, char* argv[]) {
     try {
         core::log::init_logger();
 
-        boost::asio::io_context ioc;
+        const auto [config, strategy, bus, options, latencyReport, logLevel] =
+            ParseArgs(argc, argv);
+        spdlog::set_level(logLevel);
+
+        std::optional<core::metrics::LatencyReporter> latencyReporter;
+        if (latencyReport.count() > 0) {
+            latencyReporter.emplace(latencyReport);
+        }
 
-        auto depthHandler = std::make_unique<exchange::binance::Handler>(ioc);
+        engine::Pipeline pipeline{options};
+
+        // combined streams of all handlers share the connections of one connector
+        std::shared_ptr<exchange::binance::Connector> connector;
+        if (config.streamsPerConnection != 0) {
+            connector =
+                std::make_shared<exchange::binance::Connector>(pipeline.NextContext(), config);
+        }
+        const auto makeHandler = [&]() {
+            return connector ? std::make_unique<exchange::binance::Handler>(connector, config)
+                             : std::make_unique<exchange::binance::Handler>(
+                                   pipeline.NextContext(), config);
+        };
+
+        auto depthHandler = makeHandler();
         depthHandler->AddTarget(exchange::binance::EventType::Depth, "/ws/ethusdt@depth20@100ms");
 
-        auto tradeHandler = std::make_unique<exchange::binance::Handler>(ioc);
+        auto tradeHandler = makeHandler();
         tradeHandler->AddTarget(exchange::binance::EventType::Trade, "/ws/ethusdt@trade@50ms");
 
-        engine::Pipeline pipeline;
+        // depth and trade events of the symbol feed one strategy
+        auto eventBus = std::make_unique<engine::EventBus>(bus);
+        const auto symbol = eventBus->AddSymbol(strategy);
+        eventBus->AddSource(symbol, *depthHandler);
+        eventBus->AddSource(symbol, *tradeHandler);
+
         pipeline.AddHandler(std::move(depthHandler));
         pipeline.AddHandler(std::move(tradeHandler));
+        pipeline.AddHandler(std::move(eventBus));
 
         pipeline.Init();
+        pipeline.Start();
 
-        ioc.run();
+        pipeline.Run();
+        pipeline.Stop();
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
         return 1;
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace network::capture {
+
+/**
+ * @brief Layout of a capture file produced by Recorder and consumed by Reader.
+ *
+ * A capture file starts with a FileHeader followed by a sequence of frames.
+ * Each frame is a FrameHeader immediately followed by `size` payload bytes,
+ * padded with zeros up to `frameAlignment`. The file is preallocated in chunks,
+ * so a frame header with zero timestamp and size marks the end of the data
+ * if the recorder did not shut down cleanly.
+ */
+static constexpr std::array<char, 8> fileMagic = {'Q', 'D', 'C', 'A', 'P', 0, 0, 0};
+static constexpr uint32_t fileVersion = 1;       /**< Current capture format version. */
+static constexpr std::size_t frameAlignment = 8; /**< Alignment of every frame header. */
+
+/**
+ * @brief Header written once at the beginning of a capture file.
+ */
+struct FileHeader {
+    std::array<char, 8> magic; /**< Must be equal to `fileMagic`. */
+    uint32_t version;          /**< Capture format version. */
+    uint32_t reserved;         /**< Reserved, always zero. */
+};
+
+/**
+ * @brief Header preceding every captured frame.
+ */
+struct FrameHeader {
+    uint64_t tsNs;     /**< Receive timestamp in nanoseconds since epoch. */
+    uint32_t size;     /**< Payload size in bytes. */
+    uint32_t reserved; /**< Reserved, always zero. */
+};
+
+static_assert(sizeof(FileHeader) % frameAlignment == 0);
+static_assert(sizeof(FrameHeader) % frameAlignment == 0);
+
+/**
+ * @brief Returns the number of bytes occupied by a frame with the given payload size.
+ *
+ * @param size Payload size in bytes.
+ * @return Size of the header plus the padded payload.
+ */
+constexpr std::size_t FrameFootprint(std::size_t size) noexcept {
+    return sizeof(FrameHeader) + (size + frameAlignment - 1) / frameAlignment * frameAlignment;
+}
+
+}  // namespace network::capture
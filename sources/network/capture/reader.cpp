@@ -0,0 +1,82 @@
+#include "reader.hpp"
+
+#include <fcntl.h>
+#include <fmt/format.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include "capture_file.hpp"
+
+namespace network::capture {
+
+Reader::Reader(const std::filesystem::path& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error{
+            fmt::format("Failed to open capture file {}: {}", path.string(), std::strerror(errno))};
+    }
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(FileHeader)) {
+        ::close(fd);
+        throw std::runtime_error{fmt::format("Capture file {} is too short", path.string())};
+    }
+
+    m_size = static_cast<std::size_t>(st.st_size);
+    void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        throw std::runtime_error{
+            fmt::format("Failed to map capture file {}: {}", path.string(), std::strerror(errno))};
+    }
+    m_data = static_cast<const std::byte*>(data);
+
+    FileHeader header;
+    std::memcpy(&header, m_data, sizeof(header));
+    if (header.magic != fileMagic || header.version != fileVersion) {
+        ::munmap(const_cast<std::byte*>(m_data), m_size);
+        throw std::runtime_error{
+            fmt::format("File {} is not a capture file of version {}", path.string(), fileVersion)};
+    }
+
+    Rewind();
+}
+
+bool Reader::Next(Frame& frame) noexcept {
+    if (m_offset + sizeof(FrameHeader) > m_size) {
+        return false;
+    }
+
+    FrameHeader header;
+    std::memcpy(&header, m_data + m_offset, sizeof(header));
+    if (header.tsNs == 0 && header.size == 0) {
+        return false;  // preallocated tail of an unfinished capture
+    }
+
+    const auto footprint = FrameFootprint(header.size);
+    if (m_offset + sizeof(FrameHeader) + header.size > m_size) [[unlikely]] {
+        return false;  // truncated frame
+    }
+
+    frame.tsNs = header.tsNs;
+    frame.data = std::span<const std::byte>{m_data + m_offset + sizeof(FrameHeader), header.size};
+    m_offset += footprint;
+    return true;
+}
+
+void Reader::Rewind() noexcept {
+    m_offset = sizeof(FileHeader);
+}
+
+Reader::~Reader() {
+    if (m_data != nullptr) {
+        ::munmap(const_cast<std::byte*>(m_data), m_size);
+    }
+}
+
+}  // namespace network::capture
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+namespace network::capture {
+
+/**
+ * @brief A single frame read from a capture file.
+ */
+struct Frame {
+    uint64_t tsNs;                   /**< Receive timestamp in nanoseconds since epoch. */
+    std::span<const std::byte> data; /**< Frame payload, valid while the Reader is alive. */
+};
+
+/**
+ * @brief Sequential reader of capture files produced by Recorder.
+ *
+ * The whole file is mapped read-only, frames are returned as views into
+ * the mapping without copying.
+ */
+class Reader final {
+public:
+    /**
+     * @brief Opens and maps a capture file, validating its header.
+     *
+     * @param path Path to the capture file.
+     * @throws std::runtime_error If the file cannot be opened, mapped or has an invalid header.
+     */
+    explicit Reader(const std::filesystem::path& path);
+
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    /**
+     * @brief Reads the next frame.
+     *
+     * @param frame Output frame.
+     * @return True if a frame was read; false at the end of the capture.
+     */
+    bool Next(Frame& frame) noexcept;
+
+    /**
+     * @brief Rewinds the reader to the first frame.
+     */
+    void Rewind() noexcept;
+
+    /**
+     * @brief Unmaps the capture file.
+     */
+    ~Reader();
+
+private:
+    const std::byte* m_data{nullptr}; /**< Start of the mapped file. */
+    std::size_t m_size{0};            /**< Size of the mapped file in bytes. */
+    std::size_t m_offset{0};          /**< Offset of the next frame header. */
+};
+
+}  // namespace network::capture
@@ -0,0 +1,98 @@
+#include "recorder.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <core/log/log.hpp>
+#include <cstring>
+#include <stdexcept>
+
+#include "capture_file.hpp"
+
+namespace network::capture {
+
+Recorder::Recorder(const std::filesystem::path& path) : m_path(path) {
+    m_fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (m_fd < 0) {
+        throw std::runtime_error{
+            fmt::format("Failed to open capture file {}: {}", path.string(), std::strerror(errno))};
+    }
+
+    if (!Grow(sizeof(FileHeader))) {
+        ::close(m_fd);
+        throw std::runtime_error{fmt::format("Failed to map capture file {}", path.string())};
+    }
+
+    const FileHeader header{.magic = fileMagic, .version = fileVersion, .reserved = 0};
+    std::memcpy(m_data, &header, sizeof(header));
+    m_size = sizeof(header);
+
+    LOG(info, "Recording frames to {}", m_path.string());
+}
+
+void Recorder::Append(uint64_t tsNs, std::span<const std::byte> data) noexcept {
+    if (m_data == nullptr) [[unlikely]] {
+        return;
+    }
+
+    const auto footprint = FrameFootprint(data.size());
+    if (m_size + footprint > m_capacity && !Grow(m_size + footprint)) [[unlikely]] {
+        LOG(err, "Failed to extend capture file {}. Recording is disabled", m_path.string());
+        if (m_data != nullptr) {
+            ::munmap(m_data, m_capacity);
+            m_data = nullptr;
+        }
+        return;
+    }
+
+    const FrameHeader header{
+        .tsNs = tsNs, .size = static_cast<uint32_t>(data.size()), .reserved = 0};
+    std::memcpy(m_data + m_size, &header, sizeof(header));
+    std::memcpy(m_data + m_size + sizeof(header), data.data(), data.size());
+    m_size += footprint;
+}
+
+bool Recorder::Grow(std::size_t minCapacity) noexcept {
+    auto capacity = m_capacity;
+    while (capacity < minCapacity) {
+        capacity += chunkSize;
+    }
+
+    if (::ftruncate(m_fd, static_cast<off_t>(capacity)) != 0) {
+        LOG(err, "Failed to resize capture file {}: {}", m_path.string(), std::strerror(errno));
+        return false;
+    }
+
+    if (m_data != nullptr) {
+        ::munmap(m_data, m_capacity);
+        m_data = nullptr;
+    }
+
+    void* data = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (data == MAP_FAILED) {
+        LOG(err, "Failed to map capture file {}: {}", m_path.string(), std::strerror(errno));
+        return false;
+    }
+
+    m_data = static_cast<std::byte*>(data);
+    m_capacity = capacity;
+    return true;
+}
+
+Recorder::~Recorder() {
+    if (m_data != nullptr) {
+        ::munmap(m_data, m_capacity);
+    }
+    if (m_fd >= 0) {
+        if (::ftruncate(m_fd, static_cast<off_t>(m_size)) != 0) {
+            LOG(warn, "Failed to truncate capture file {}: {}", m_path.string(),
+                std::strerror(errno));
+        }
+        ::close(m_fd);
+    }
+    LOG(info, "Recorded {} bytes to {}", m_size, m_path.string());
+}
+
+}  // namespace network::capture
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+namespace network::capture {
+
+/**
+ * @brief Append-only recorder of raw frames into a memory-mapped capture file.
+ *
+ * The Recorder preallocates the capture file in fixed chunks and maps it into
+ * memory, so appending a frame is a pair of memcpy calls on the receive path.
+ * When the mapping is exhausted the file is extended by another chunk and
+ * remapped. On destruction the file is truncated to the recorded data size.
+ * The file layout is described in capture_file.hpp.
+ */
+class Recorder final {
+public:
+    static constexpr std::size_t chunkSize = 64 << 20; /**< File growth step in bytes. */
+
+    /**
+     * @brief Creates (or truncates) a capture file and writes its header.
+     *
+     * @param path Path to the capture file.
+     * @throws std::runtime_error If the file cannot be created or mapped.
+     */
+    explicit Recorder(const std::filesystem::path& path);
+
+    Recorder(const Recorder&) = delete;
+    Recorder& operator=(const Recorder&) = delete;
+
+    /**
+     * @brief Appends a frame to the capture file.
+     *
+     * If the file cannot be extended, recording is disabled and the error is logged;
+     * the caller is never interrupted.
+     *
+     * @param tsNs Receive timestamp of the frame in nanoseconds since epoch.
+     * @param data Raw frame bytes.
+     */
+    void Append(uint64_t tsNs, std::span<const std::byte> data) noexcept;
+
+    /**
+     * @brief Flushes the mapping, truncates the file to its data size and closes it.
+     */
+    ~Recorder();
+
+private:
+    /**
+     * @brief Extends the file and the mapping to hold at least `minCapacity` bytes.
+     *
+     * @param minCapacity Required capacity in bytes.
+     * @return True on success; otherwise false.
+     */
+    bool Grow(std::size_t minCapacity) noexcept;
+
+private:
+    std::filesystem::path m_path; /**< Path to the capture file (for diagnostics). */
+    int m_fd{-1};                 /**< File descriptor of the capture file. */
+    std::byte* m_data{nullptr};   /**< Start of the mapped region. */
+    std::size_t m_capacity{0};    /**< Size of the mapped region in bytes. */
+    std::size_t m_size{0};        /**< Number of bytes written so far. */
+};
+
+}  // namespace network::capture
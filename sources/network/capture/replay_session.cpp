@@ -0,0 +1,130 @@
+#include "replay_session.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <chrono>
+#include <core/error_handling/error_handling.hpp>
+#include <core/log/log.hpp>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "reader.hpp"
+
+namespace network::capture {
+
+namespace ceh = core::error_handling;
+namespace net = boost::asio;
+
+class ReplaySession::Impl final : public std::enable_shared_from_this<Impl> {
+public:
+    Impl(net::io_context& ioc, std::filesystem::path path, Pace pace)
+        : m_timer(net::make_strand(ioc)), m_path(std::move(path)), m_pace(pace) {}
+
+    void Start(core::interface::INotifier* notifier) {
+        m_notifier = notifier;
+
+        try {
+            m_reader.emplace(m_path);
+        } catch (const std::exception& e) {
+            LOG(err, "Failed to open capture for replay: {}", e.what());
+            m_notifier->OnConnectionFailed(ceh::ErrorCode::eConnectionFailed);
+            return;
+        }
+
+        net::post(m_timer.get_executor(), [self = shared_from_this()] {
+            LOG(info, "Replaying {}", self->m_path.string());
+            self->m_notifier->OnConnectionSuccessed();
+            self->m_startedAt = std::chrono::steady_clock::now();
+            self->ReadNext();
+        });
+    }
+
+    inline void Close() noexcept {
+        m_closed = true;
+        m_timer.cancel();
+    }
+
+private:
+    void ReadNext() {
+        if (m_closed) {
+            return;
+        }
+
+        if (!m_reader->Next(m_frame)) {
+            LOG(info, "Replay of {} finished", m_path.string());
+            m_notifier->OnStop();
+            return;
+        }
+
+        if (m_pace == Pace::Fast) {
+            net::post(m_timer.get_executor(), [self = shared_from_this()] { self->Deliver(); });
+            return;
+        }
+
+        if (m_firstTsNs == 0) {
+            m_firstTsNs = m_frame.tsNs;
+        }
+        m_timer.expires_at(m_startedAt + std::chrono::nanoseconds(m_frame.tsNs - m_firstTsNs));
+        m_timer.async_wait([self = shared_from_this()](boost::system::error_code ec) {
+            if (ec) {
+                return;
+            }
+            self->Deliver();
+        });
+    }
+
+    void Deliver() {
+        if (m_closed) {
+            return;
+        }
+
+        if (m_notifier->OnStopRequested()) {
+            m_notifier->OnStop();
+            return;
+        }
+
+        const auto size = m_frame.data.size();
+        m_storage.resize(size + core::interface::receivePadding);
+        std::copy(m_frame.data.begin(), m_frame.data.end(), m_storage.begin());
+        m_notifier->OnReceiveSuccessed(std::span<std::byte>{m_storage.data(), size},
+                                       m_frame.tsNs);
+        ReadNext();
+    }
+
+private:
+    net::steady_timer m_timer;                         /**< Pacing timer, bound to a strand. */
+    std::filesystem::path m_path;                      /**< Path to the capture file. */
+    Pace m_pace;                                       /**< Replay speed. */
+    std::optional<Reader> m_reader;                    /**< Capture reader. */
+    Frame m_frame{};                                   /**< Frame pending delivery. */
+    std::vector<std::byte> m_storage;                  /**< Mutable, padded copy of the frame. */
+    uint64_t m_firstTsNs{0};                           /**< Timestamp of the first frame. */
+    std::chrono::steady_clock::time_point m_startedAt; /**< Replay start time. */
+    std::atomic<bool> m_closed{false};                 /**< Set once the session is closed. */
+    core::interface::INotifier* m_notifier{nullptr};   /**< Notifier for event callbacks. */
+};
+
+ReplaySession::ReplaySession(boost::asio::io_context& ioc, std::filesystem::path path, Pace pace)
+    : m_impl{std::make_shared<Impl>(ioc, std::move(path), pace)} {}
+
+void ReplaySession::Connect(std::string_view, std::string_view, uint16_t,
+                            core::interface::INotifier* notifier) noexcept {
+    m_impl->Start(notifier);
+}
+
+void ReplaySession::Send(std::string message) {
+    LOG(debug, "Dropped message sent to a replay: {}", message);
+}
+
+void ReplaySession::SetTarget(std::string_view) {}
+
+ReplaySession::~ReplaySession() {
+    m_impl->Close();
+}
+
+}  // namespace network::capture
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <boost/asio/io_context.hpp>
+#include <core/interface/session.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace network::capture {
+
+/**
+ * @brief Replay speed of a ReplaySession.
+ */
+enum class Pace {
+    Recorded, /**< Frames are delivered with the inter-arrival gaps of the capture. */
+    Fast      /**< Frames are delivered back to back, as fast as the consumer allows. */
+};
+
+/**
+ * @brief Session that replays a capture file instead of connecting to the network.
+ *
+ * The ReplaySession implements ISession on top of a capture file written by
+ * Recorder. Frames are delivered through INotifier::OnReceiveSuccessed on the
+ * given io_context, either at the recorded pace or as fast as possible.
+ * When the capture is exhausted INotifier::OnStop is invoked.
+ */
+class ReplaySession final : public core::interface::ISession {
+public:
+    /**
+     * @brief Constructs a replay session.
+     *
+     * @param ioc Reference to a Boost.Asio io_context the frames are delivered on.
+     * @param path Path to the capture file.
+     * @param pace Replay speed.
+     */
+    ReplaySession(boost::asio::io_context& ioc, std::filesystem::path path, Pace pace);
+
+    /**
+     * @brief Starts replaying the capture file.
+     *
+     * Network parameters are ignored; they are accepted to keep ISession semantics.
+     * A capture that cannot be opened is reported via OnConnectionFailed.
+     *
+     * @param source Ignored.
+     * @param target Ignored.
+     * @param port Ignored.
+     * @param notifier Pointer to an INotifier instance for event callbacks.
+     */
+    void Connect(std::string_view source, std::string_view target, uint16_t port,
+                 core::interface::INotifier* notifier) noexcept override;
+
+    /**
+     * @brief Drops the message; a capture cannot be sent to.
+     *
+     * Requests are not recorded, so a replay always delivers the streams that were
+     * received while recording, including the effect of requests sent back then.
+     *
+     * @param message Ignored.
+     */
+    void Send(std::string message) override;
+
+    /**
+     * @brief Ignored; a replay does not reconnect.
+     *
+     * @param target Ignored.
+     */
+    void SetTarget(std::string_view target) override;
+
+    /**
+     * @brief Destructor. Stops the replay.
+     */
+    ~ReplaySession();
+
+private:
+    /**
+     * @brief Private implementation (PIMPL) to hide internal details.
+     */
+    class Impl;
+
+    std::shared_ptr<Impl> m_impl; /**< Pointer to the implementation details. */
+};
+
+}  // namespace network::capture
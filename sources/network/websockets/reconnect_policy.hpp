@@ -0,0 +1,44 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+namespace network::websockets {
+
+/**
+ * @brief Reconnect and liveness settings of a WebSocket session.
+ */
+struct ReconnectPolicy {
+    std::chrono::milliseconds initialBackoff{100};    /**< Delay before the first reconnect. */
+    std::chrono::milliseconds maxBackoff{30'000};     /**< Upper bound of the delay. */
+    double multiplier = 2;                            /**< Delay growth per failed attempt. */
+    std::size_t maxAttempts = 10;                     /**< Consecutive failed attempts allowed. */
+    std::chrono::milliseconds connectTimeout{10'000}; /**< Limit of connect and handshakes. */
+    std::chrono::milliseconds idleTimeout{10'000};    /**< Silence that counts as a dead link. */
+};
+
+/**
+ * @brief Returns the delay before a reconnect attempt ("full jitter").
+ *
+ * The delay is drawn uniformly from [0, min(maxBackoff, initialBackoff * multiplier^attempt)],
+ * so sessions that dropped together do not reconnect in lockstep.
+ *
+ * @param policy Reconnect policy.
+ * @param attempt Number of failed attempts so far, starting from 0.
+ * @param rng Random number generator.
+ */
+template <typename Rng>
+std::chrono::milliseconds Backoff(const ReconnectPolicy& policy, std::size_t attempt, Rng& rng) {
+    double cap = static_cast<double>(policy.initialBackoff.count());
+    const auto max = static_cast<double>(policy.maxBackoff.count());
+    for (std::size_t i = 0; i < attempt && cap < max; ++i) {
+        cap *= policy.multiplier;
+    }
+    std::uniform_real_distribution<double> jitter{0, std::min(cap, max)};
+    return std::chrono::milliseconds{static_cast<int64_t>(jitter(rng))};
+}
+
+}  // namespace network::websockets
@@ -1,31 +1,131 @@
 #include "session.hpp"
 
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <core/log/log.hpp>
+#include <random>
+#include <string>
+
 #include "websocket.hpp"
 
 namespace network::websockets {
-class Session::Impl {
+class Session::Impl final : public std::enable_shared_from_this<Impl> {
 public:
-    explicit Impl(boost::asio::io_context& ioc) : m_ws{std::make_shared<Websocket>(ioc)} {}
+    Impl(boost::asio::io_context& ioc, std::unique_ptr<capture::Recorder> recorder,
+         const ReconnectPolicy& policy)
+        : m_ioc(ioc),
+          m_timer(net::make_strand(ioc)),
+          m_recorder(std::move(recorder)),
+          m_policy(policy),
+          m_rng(std::random_device{}()) {}
 
     void Connect(std::string_view source, std::string_view target, uint16_t port,
                  core::interface::INotifier* notifier) {
-        m_ws->SetNotifier(notifier);
-        m_ws->Run(source, target, port);
+        m_source = source;
+        m_target = target;
+        m_port = port;
+        m_notifier = notifier;
+        Open();
+    }
+
+    void Send(std::string message) {
+        net::post(m_timer.get_executor(),
+                  [self = shared_from_this(), message = std::move(message)]() mutable {
+                      if (self->m_ws) {
+                          self->m_ws->Send(std::move(message));
+                      }
+                  });
     }
 
-    inline void Close() noexcept { m_ws->Close(); }
+    inline void SetTarget(std::string_view target) { m_target = target; }
+
+    void Close() noexcept {
+        m_closed = true;
+        m_timer.cancel();
+        if (m_ws) {
+            m_ws->Close();
+        }
+    }
 
 private:
+    void Open() {
+        m_ws = std::make_shared<Websocket>(m_ioc, m_policy);
+        m_ws->SetNotifier(m_notifier);
+        if (m_recorder) {
+            m_ws->SetRecorder(m_recorder);
+        }
+        m_ws->SetCloseHandler([weak = weak_from_this()](bool wasOpen) {
+            if (auto self = weak.lock()) {
+                net::post(self->m_timer.get_executor(),
+                          [self, wasOpen] { self->OnClosed(wasOpen); });
+            }
+        });
+        m_ws->Run(m_source, m_target, m_port);
+    }
+
+    void OnClosed(bool wasOpen) {
+        if (m_closed) {
+            return;
+        }
+
+        // the budget limits consecutive failures, a connection that came up restores it
+        if (wasOpen) {
+            m_attempts = 0;
+        }
+        if (m_attempts >= m_policy.maxAttempts) {
+            LOG(critical, "Giving up on target {}/{} after {} reconnect attempts", m_source,
+                m_target, m_attempts);
+            m_notifier->OnStop();
+            return;
+        }
+
+        const auto delay = Backoff(m_policy, m_attempts++, m_rng);
+        LOG(warn, "Reconnecting to target {}/{} in {} ms. Attempt {}/{}", m_source, m_target,
+            delay.count(), m_attempts, m_policy.maxAttempts);
+
+        m_timer.expires_after(delay);
+        m_timer.async_wait([self = shared_from_this()](boost::system::error_code ec) {
+            if (!ec && !self->m_closed) {
+                self->Open();
+            }
+        });
+    }
+
+private:
+    boost::asio::io_context& m_ioc;
+    boost::asio::steady_timer m_timer;
+    std::shared_ptr<capture::Recorder> m_recorder;
+    ReconnectPolicy m_policy;
+    std::mt19937_64 m_rng;
+
     std::shared_ptr<Websocket> m_ws;
+    std::string m_source;
+    std::string m_target;
+    uint16_t m_port = 0;
+    core::interface::INotifier* m_notifier = nullptr;
+
+    std::size_t m_attempts = 0;
+    bool m_closed = false;
 };
 
-Session::Session(boost::asio::io_context& ioc) : m_impl{new Session::Impl(ioc)} {}
+Session::Session(boost::asio::io_context& ioc, std::unique_ptr<capture::Recorder> recorder,
+                 const ReconnectPolicy& policy)
+    : m_impl{std::make_shared<Session::Impl>(ioc, std::move(recorder), policy)} {}
 
 void Session::Connect(std::string_view source, std::string_view target, uint16_t port,
                       core::interface::INotifier* notifier) noexcept {
     m_impl->Connect(source, target, port, notifier);
 }
 
+void Session::Send(std::string message) {
+    m_impl->Send(std::move(message));
+}
+
+void Session::SetTarget(std::string_view target) {
+    m_impl->SetTarget(target);
+}
+
 Session::~Session() {
     m_impl->Close();
 }
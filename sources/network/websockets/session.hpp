@@ -4,8 +4,12 @@
 #include <core/interface/session.hpp>
 #include <cstdint>
 #include <memory>
+#include <network/capture/recorder.hpp>
+#include <string>
 #include <string_view>
 
+#include "reconnect_policy.hpp"
+
 namespace network::websockets {
 
 /**
@@ -14,6 +18,12 @@ namespace network::websockets {
  * The Session class establishes and manages a WebSocket connection
  * to a given source and target using Boost.Asio. Events and status
  * updates are communicated via an INotifier.
+ *
+ * A failed or lost connection (including one silent for the idle timeout) is
+ * reported via OnConnectionFailed/OnReceiveFailed and re-established after a
+ * jittered exponential backoff. After `maxAttempts` consecutive failed attempts the
+ * session gives up and invokes OnStop. Every new connection is reported via
+ * OnConnectionSuccessed, so that the owner can resync its state.
  */
 class Session final : public core::interface::ISession {
 public:
@@ -21,8 +31,12 @@ public:
      * @brief Constructs a WebSocket session.
      *
      * @param ioc Reference to a Boost.Asio io_context for asynchronous operations.
+     * @param recorder Optional recorder every received frame is captured to.
+     * @param policy Reconnect and liveness settings.
      */
-    explicit Session(boost::asio::io_context& ioc);
+    explicit Session(boost::asio::io_context& ioc,
+                     std::unique_ptr<capture::Recorder> recorder = nullptr,
+                     const ReconnectPolicy& policy = {});
 
     /**
      * @brief Establishes a connection to the specified source and target.
@@ -38,6 +52,24 @@ public:
     void Connect(std::string_view source, std::string_view target, uint16_t port,
                  core::interface::INotifier* notifier) noexcept override;
 
+    /**
+     * @brief Sends a text message over the WebSocket.
+     *
+     * Implements the ISession interface.
+     *
+     * @param message The message to send.
+     */
+    void Send(std::string message) override;
+
+    /**
+     * @brief Changes the target used by later reconnects.
+     *
+     * Implements the ISession interface.
+     *
+     * @param target The new target.
+     */
+    void SetTarget(std::string_view target) override;
+
     /**
      * @brief Destructor. Cleans up internal resources.
      */
@@ -49,7 +81,7 @@ private:
      */
     class Impl;
 
-    std::unique_ptr<Impl> m_impl; /**< Pointer to the implementation details. */
+    std::shared_ptr<Impl> m_impl; /**< Pointer to the implementation details. */
 };
 
 }  // namespace network::websockets
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <array>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/compose.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/beast/core/tcp_stream.hpp>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <utility>
+
+namespace network::websockets {
+
+/**
+ * @brief TCP stream layer that reports kernel receive timestamps.
+ *
+ * Wraps a beast::tcp_stream and forwards everything to it until EnableTimestamps()
+ * is called. From then on reads are done with recvmsg() on the socket with
+ * SO_TIMESTAMPNS enabled, and the kernel timestamp of the last received segment is
+ * available via LastReceiveNs(). Reads in this mode bypass the tcp_stream timeout,
+ * so it is meant to be enabled once the handshakes are done and liveness is left to
+ * the websocket timeouts.
+ *
+ * Sits between the TLS layer and the TCP stream, so a decrypted message is stamped
+ * with the arrival of the segment that completed it, or of an earlier one if its
+ * bytes were already buffered by TLS.
+ */
+class TimestampedStream final {
+public:
+    using next_layer_type = boost::beast::tcp_stream;             /**< Wrapped stream. */
+    using lowest_layer_type = next_layer_type::socket_type;       /**< TCP socket. */
+    using executor_type = next_layer_type::executor_type;         /**< Executor type. */
+    using error_code = boost::system::error_code;                 /**< Error code. */
+
+    /**
+     * @brief Constructs the wrapped TCP stream from the given arguments.
+     */
+    template <typename... Args>
+    explicit TimestampedStream(Args&&... args) : m_stream(std::forward<Args>(args)...) {}
+
+    inline executor_type get_executor() noexcept { return m_stream.get_executor(); }
+    inline next_layer_type& next_layer() noexcept { return m_stream; }
+    inline const next_layer_type& next_layer() const noexcept { return m_stream; }
+    inline lowest_layer_type& lowest_layer() noexcept { return m_stream.socket(); }
+    inline const lowest_layer_type& lowest_layer() const noexcept { return m_stream.socket(); }
+
+    /**
+     * @brief Turns on kernel receive timestamps and recvmsg() reads.
+     *
+     * @return True if the socket accepted SO_TIMESTAMPNS; otherwise reads keep going
+     * through the tcp_stream and no timestamps are reported.
+     */
+    bool EnableTimestamps() noexcept {
+        const int on = 1;
+        m_enabled = ::setsockopt(m_stream.socket().native_handle(), SOL_SOCKET, SO_TIMESTAMPNS,
+                                 &on, sizeof(on)) == 0;
+        return m_enabled;
+    }
+
+    /**
+     * @brief Returns the kernel timestamp of the last received segment.
+     *
+     * @return Nanoseconds since the epoch, 0 if no timestamp was received yet.
+     */
+    inline uint64_t LastReceiveNs() const noexcept { return m_lastReceiveNs; }
+
+    /**
+     * @brief Synchronous operations (e.g. a blocking close) go to the TCP stream unstamped.
+     */
+    template <typename MutableBufferSequence>
+    std::size_t read_some(const MutableBufferSequence& buffers, error_code& ec) {
+        return m_stream.read_some(buffers, ec);
+    }
+
+    template <typename MutableBufferSequence>
+    std::size_t read_some(const MutableBufferSequence& buffers) {
+        return m_stream.read_some(buffers);
+    }
+
+    template <typename ConstBufferSequence>
+    std::size_t write_some(const ConstBufferSequence& buffers, error_code& ec) {
+        return m_stream.write_some(buffers, ec);
+    }
+
+    template <typename ConstBufferSequence>
+    std::size_t write_some(const ConstBufferSequence& buffers) {
+        return m_stream.write_some(buffers);
+    }
+
+    template <typename ConstBufferSequence, typename WriteHandler>
+    auto async_write_some(const ConstBufferSequence& buffers, WriteHandler&& handler) {
+        return m_stream.async_write_some(buffers, std::forward<WriteHandler>(handler));
+    }
+
+    template <typename MutableBufferSequence, typename ReadHandler>
+    auto async_read_some(const MutableBufferSequence& buffers, ReadHandler&& handler) {
+        return boost::asio::async_compose<ReadHandler, void(error_code, std::size_t)>(
+            ReadOp<MutableBufferSequence>{*this, buffers}, handler, m_stream);
+    }
+
+private:
+    /**
+     * @brief Composed read: a speculative recvmsg(), then waits for readability.
+     */
+    template <typename MutableBufferSequence>
+    struct ReadOp {
+        enum class State { Start, Forwarded, Waiting, Done };
+
+        TimestampedStream& stream;
+        MutableBufferSequence buffers;
+        State state = State::Start;
+        error_code result{};
+        std::size_t transferred = 0;
+
+        template <typename Self>
+        void operator()(Self& self, error_code ec = {}, std::size_t n = 0) {
+            namespace net = boost::asio;
+
+            switch (state) {
+                case State::Start:
+                    if (!stream.m_enabled) {
+                        state = State::Forwarded;
+                        stream.m_stream.async_read_some(buffers, std::move(self));
+                        return;
+                    }
+                    if (net::buffer_size(buffers) == 0) {
+                        state = State::Done;
+                    } else {
+                        transferred = stream.Receive(buffers, result);
+                        state = result == net::error::would_block ? State::Waiting : State::Done;
+                    }
+                    if (state == State::Waiting) {
+                        stream.m_stream.socket().async_wait(net::socket_base::wait_read,
+                                                            std::move(self));
+                    } else {
+                        // completing inline is not allowed, go through the executor
+                        net::post(std::move(self));
+                    }
+                    return;
+                case State::Waiting:
+                    if (!ec) {
+                        n = stream.Receive(buffers, ec);
+                        if (ec == net::error::would_block) {
+                            stream.m_stream.socket().async_wait(net::socket_base::wait_read,
+                                                                std::move(self));
+                            return;
+                        }
+                    }
+                    self.complete(ec, n);
+                    return;
+                case State::Forwarded:
+                    self.complete(ec, n);
+                    return;
+                case State::Done:
+                    self.complete(result, transferred);
+                    return;
+            }
+        }
+    };
+
+    /**
+     * @brief Reads what the socket has without blocking and records its timestamp.
+     */
+    template <typename MutableBufferSequence>
+    std::size_t Receive(const MutableBufferSequence& buffers, error_code& ec) noexcept {
+        std::array<iovec, 16> iov;
+        std::size_t count = 0;
+        for (auto it = boost::asio::buffer_sequence_begin(buffers);
+             it != boost::asio::buffer_sequence_end(buffers) && count < iov.size(); ++it) {
+            const boost::asio::mutable_buffer buffer = *it;
+            iov[count++] = iovec{buffer.data(), buffer.size()};
+        }
+
+        alignas(cmsghdr) std::array<char, CMSG_SPACE(sizeof(timespec))> control;
+        msghdr msg{};
+        msg.msg_iov = iov.data();
+        msg.msg_iovlen = count;
+        msg.msg_control = control.data();
+        msg.msg_controllen = control.size();
+
+        ssize_t received;
+        do {
+            received = ::recvmsg(m_stream.socket().native_handle(), &msg, MSG_DONTWAIT);
+        } while (received < 0 && errno == EINTR);
+
+        if (received < 0) {
+            ec = errno == EAGAIN || errno == EWOULDBLOCK
+                     ? error_code{boost::asio::error::would_block}
+                     : error_code{errno, boost::system::system_category()};
+            return 0;
+        }
+        if (received == 0) {
+            ec = boost::asio::error::eof;
+            return 0;
+        }
+
+        for (auto* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+            if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+                timespec ts;
+                std::memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+                m_lastReceiveNs = static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000 +
+                                  static_cast<uint64_t>(ts.tv_nsec);
+            }
+        }
+        ec = {};
+        return static_cast<std::size_t>(received);
+    }
+
+private:
+    next_layer_type m_stream;     /**< Wrapped TCP stream. */
+    bool m_enabled = false;       /**< Reads go through recvmsg() with timestamps. */
+    uint64_t m_lastReceiveNs = 0; /**< Kernel timestamp of the last received segment. */
+};
+
+}  // namespace network::websockets
@@ -0,0 +1,77 @@
+#include "tls_context.hpp"
+
+#include <core/log/log.hpp>
+#include <utility>
+
+namespace network::websockets {
+
+namespace ssl = boost::asio::ssl;
+
+TlsContext& TlsContext::Instance() {
+    static TlsContext context;
+    return context;
+}
+
+TlsContext::TlsContext() : m_ctx(ssl::context::tls_client) {
+    m_ctx.set_options(ssl::context::no_sslv2 | ssl::context::no_sslv3 |
+                      ssl::context::single_dh_use);
+
+    boost::system::error_code ec;
+    m_ctx.set_default_verify_paths(ec);
+    if (ec) {
+        // handshakes will fail verification and be reported per connection
+        LOG(critical, "Failed to load default CA paths. Ec: {} -> {}", ec.value(), ec.message());
+    }
+    m_ctx.set_verify_mode(ssl::verify_peer);
+
+    // clients are only told about new sessions with the client cache on, the internal
+    // store is keyed by session id and useless for picking a session by host
+    auto* native = m_ctx.native_handle();
+    SSL_CTX_set_session_cache_mode(native,
+                                   SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(native, &TlsContext::OnNewSession);
+}
+
+bool TlsContext::Resume(SSL* ssl, std::string_view host) {
+    session_t session;
+    {
+        std::lock_guard lock{m_mutex};
+        const auto it = m_sessions.find(std::string{host});
+        if (it == m_sessions.end()) {
+            return false;
+        }
+        if (!SSL_SESSION_is_resumable(it->second.get())) {
+            m_sessions.erase(it);
+            return false;
+        }
+        session = it->second;
+    }
+
+    // SSL_set_session takes its own reference
+    return SSL_set_session(ssl, session.get()) == 1;
+}
+
+void TlsContext::Forget(std::string_view host) {
+    std::lock_guard lock{m_mutex};
+    m_sessions.erase(std::string{host});
+}
+
+int TlsContext::OnNewSession(SSL* ssl, SSL_SESSION* session) {
+    const char* host = SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name);
+    if (host == nullptr) {
+        return 0;
+    }
+
+    // a connection dropped without a TLS shutdown marks its session as not resumable, keep
+    // a copy that outlives the connection
+    session_t copy{SSL_SESSION_dup(session), &SSL_SESSION_free};
+    if (!copy) {
+        return 0;
+    }
+
+    auto& context = Instance();
+    std::lock_guard lock{context.m_mutex};
+    context.m_sessions.insert_or_assign(std::string{host}, std::move(copy));
+    return 0;
+}
+}  // namespace network::websockets
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <openssl/ssl.h>
+
+#include <boost/asio/ssl/context.hpp>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace network::websockets {
+
+/**
+ * @brief Process-wide TLS client context with a session cache.
+ *
+ * Loading the system CA bundle and setting up a context is done once for the whole
+ * process instead of for every connection. The context also keeps the last TLS
+ * session (ticket) issued by every host, so that reconnects and further streams
+ * to the same host resume it with an abbreviated handshake instead of a full one.
+ *
+ * Sessions are keyed by the SNI host name. The cache is thread-safe, connections
+ * on any io_context may share the context.
+ */
+class TlsContext final {
+public:
+    /**
+     * @brief Returns the shared context, creating it on first use.
+     */
+    static TlsContext& Instance();
+
+    TlsContext(const TlsContext&) = delete;
+    TlsContext& operator=(const TlsContext&) = delete;
+
+    /**
+     * @brief Returns the underlying Asio SSL context.
+     */
+    inline boost::asio::ssl::context& Native() noexcept { return m_ctx; }
+
+    /**
+     * @brief Offers the cached session of a host for resumption.
+     *
+     * Must be called before the handshake, after the SNI host name is set.
+     *
+     * @param ssl Connection handle.
+     * @param host Server host name.
+     * @return True if a cached session was offered; otherwise false.
+     */
+    bool Resume(SSL* ssl, std::string_view host);
+
+    /**
+     * @brief Drops the cached session of a host, e.g., after a failed handshake.
+     *
+     * @param host Server host name.
+     */
+    void Forget(std::string_view host);
+
+private:
+    using session_t = std::shared_ptr<SSL_SESSION>; /**< Owning session pointer. */
+
+    TlsContext();
+
+    /**
+     * @brief OpenSSL callback storing a session issued by a server.
+     *
+     * @return 0, the cache keeps a copy and the connection keeps its own reference.
+     */
+    static int OnNewSession(SSL* ssl, SSL_SESSION* session);
+
+private:
+    boost::asio::ssl::context m_ctx;                       /**< Shared client context. */
+    std::mutex m_mutex;                                    /**< Guards the session cache. */
+    std::unordered_map<std::string, session_t> m_sessions; /**< Last session per host. */
+};
+
+}  // namespace network::websockets
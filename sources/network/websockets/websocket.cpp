@@ -2,27 +2,22 @@
 
 #include <core/error_handling/error_handling.hpp>
 #include <core/log/log.hpp>
+#include <core/metrics/clock.hpp>
+#include <core/metrics/latency.hpp>
 #include <span>
+#include <utility>
 
 namespace network::websockets {
 
 namespace ceh = core::error_handling;
 
-Websocket::Websocket(net::io_context& ioc)
-    : m_resolver(net::make_strand(ioc)),
-      m_ssl(ssl::context::tls_client),
-      m_ws(net::make_strand(ioc), m_ssl) {
-    m_ssl.set_options(ssl::context::no_sslv2 | ssl::context::no_sslv3 |
-                      ssl::context::single_dh_use);
+using core::metrics::NowNs;
 
-    boost::system::error_code ec;
-    m_ssl.set_default_verify_paths(ec);
-    if (ec) {
-        m_notifier->OnConnectionFailed(ceh::ErrorCode::eConnectionFailed);
-    }
-    m_ssl.set_verify_mode(ssl::verify_peer);
-
-    m_storage.reserve(maxMsgSize);
+Websocket::Websocket(net::io_context& ioc, const ReconnectPolicy& policy)
+    : m_policy(policy),
+      m_resolver(net::make_strand(ioc)),
+      m_ws(net::make_strand(ioc), TlsContext::Instance().Native()) {
+    m_buffer.reserve(maxMsgSize + core::interface::receivePadding);
 }
 
 void Websocket::Run(std::string_view source, std::string_view target, uint16_t port) {
@@ -37,18 +32,22 @@ void Websocket::OnResolve(beast::error_code ec, tcp::resolver::results_type resu
     if (ec) {
         LOG(err, "Failed to resolve target {}/{}. Ec: {} -> {}", m_host, m_target, ec.value(),
             ec.message());
-        m_notifier->OnConnectionFailed(ceh::ErrorCode::eConnectionFailed);
+        m_notifier->OnConnectionFailed(ceh::ErrorCode::eResolveFailed);
+        OnClosed();
         return;
     }
 
-    if (!SSL_set_tlsext_host_name(m_ws.next_layer().native_handle(), std::string(m_host).c_str())) {
+    if (!SSL_set_tlsext_host_name(m_ws.next_layer().native_handle(), m_host.c_str())) {
         ec = beast::error_code(static_cast<int>(::ERR_get_error()), net::error::get_ssl_category());
         LOG(err, "Failed to set SNI for target {}/{}. Ec: {} -> {}", m_host, m_target, ec.value(),
             ec.message());
         m_notifier->OnConnectionFailed(ceh::ErrorCode::eConnectionFailed);
+        OnClosed();
         return;
     }
 
+    // bounds connect and SSL handshake, the websocket timeouts take over afterwards
+    beast::get_lowest_layer(m_ws).expires_after(m_policy.connectTimeout);
     beast::get_lowest_layer(m_ws).async_connect(
         results, beast::bind_front_handler(&Websocket::OnConnect, shared_from_this()));
 }
@@ -58,9 +57,11 @@ void Websocket::OnConnect(beast::error_code ec, tcp::resolver::results_type::end
         LOG(err, "Failed to connect to target {}/{}. Ec: {} -> {}", m_host, m_target, ec.value(),
             ec.message());
         m_notifier->OnConnectionFailed(ceh::ErrorCode::eConnectionFailed);
+        OnClosed();
         return;
     }
 
+    TlsContext::Instance().Resume(m_ws.next_layer().native_handle(), m_host);
     m_ws.next_layer().async_handshake(
         ssl::stream_base::client,
         beast::bind_front_handler(&Websocket::OnSslHandshake, shared_from_this()));
@@ -72,11 +73,26 @@ void Websocket::OnSslHandshake(beast::error_code ec) {
     if (ec) {
         LOG(err, "Failed to complete SSL handshake to target {}/{}. Ec: {} -> {}", m_host, m_target,
             ec.value(), ec.message());
+        // a stale ticket must not fail the next attempt as well
+        TlsContext::Instance().Forget(m_host);
         m_notifier->OnConnectionFailed(ceh::ErrorCode::eSslHandshakeFailed);
+        OnClosed();
         return;
     }
+    LOG(debug, "SSL handshake to target {}/{} done. Resumed: {}", m_host, m_target,
+        SSL_session_reused(m_ws.next_layer().native_handle()) == 1);
 
     beast::get_lowest_layer(m_ws).expires_never();
+    if (!m_ws.next_layer().next_layer().EnableTimestamps()) {
+        LOG(warn, "Kernel receive timestamps are not available for target {}/{}", m_host,
+            m_target);
+    }
+    beast::websocket::stream_base::timeout timeout{};
+    timeout.handshake_timeout = m_policy.connectTimeout;
+    timeout.idle_timeout = m_policy.idleTimeout;
+    timeout.keep_alive_pings = true;  // ping at half of the idle timeout, fail if still silent
+    m_ws.set_option(timeout);
+
     m_notifier->OnConnectionSuccessed();
     m_ws.async_handshake(m_host, m_target,
                          beast::bind_front_handler(&Websocket::OnHandshake, shared_from_this()));
@@ -89,6 +105,7 @@ void Websocket::OnHandshake(beast::error_code ec) {
         LOG(err, "Failed to complete handshake to target {}/{}. Ec: {} -> {}", m_host, m_target,
             ec.value(), ec.message());
         m_notifier->OnConnectionFailed(ceh::ErrorCode::eHandshakeFailed);
+        OnClosed();
         return;
     }
 
@@ -100,11 +117,56 @@ void Websocket::OnHandshake(beast::error_code ec) {
                               [](boost::beast::error_code) {});
     });
 
+    m_open = true;
+    if (!m_writes.empty()) {
+        Write();
+    }
+
     m_ws.async_read(m_buffer, beast::bind_front_handler(&Websocket::OnRead, shared_from_this()));
 }
 
+void Websocket::Send(std::string message) {
+    net::post(m_ws.get_executor(),
+              [self = shared_from_this(), message = std::move(message)]() mutable {
+                  self->m_writes.push_back(std::move(message));
+                  if (self->m_open && self->m_writes.size() == 1) {
+                      self->Write();
+                  }
+              });
+}
+
+void Websocket::Write() {
+    m_ws.text(true);
+    m_ws.async_write(net::buffer(m_writes.front()),
+                     beast::bind_front_handler(&Websocket::OnWrite, shared_from_this()));
+}
+
+void Websocket::OnWrite(beast::error_code ec, std::size_t) {
+    if (ec) [[unlikely]] {
+        LOG(err, "Failed to write msg to target {}/{}. Ec: {} -> {}", m_host, m_target, ec.value(),
+            ec.message());
+        m_writes.clear();
+        return;
+    }
+
+    m_writes.pop_front();
+    if (!m_writes.empty()) {
+        Write();
+    }
+}
+
+void Websocket::OnClosed() {
+    const bool wasOpen = std::exchange(m_open, false);
+    m_writes.clear();
+    if (auto handler = std::exchange(m_onClose, nullptr)) {
+        handler(wasOpen);
+    }
+}
+
 void Websocket::OnRead(beast::error_code ec, std::size_t) {
     assert(m_notifier);
+    const auto kernelTsNs = m_ws.next_layer().next_layer().LastReceiveNs();
+    const auto tsNs = kernelTsNs != 0 ? kernelTsNs : NowNs();
 
     if (m_notifier->OnStopRequested()) {
         m_notifier->OnStop();
@@ -112,12 +174,12 @@ void Websocket::OnRead(beast::error_code ec, std::size_t) {
         return;
     }
 
+    // read errors (including the idle timeout) leave the stream unusable
     if (ec) [[unlikely]] {
-        LOG(err, "Failed to read msg. Ec: {} -> {}", ec.value(), ec.message());
+        LOG(err, "Failed to read msg from target {}/{}. Ec: {} -> {}", m_host, m_target,
+            ec.value(), ec.message());
         m_notifier->OnReceiveFailed(ceh::ErrorCode::eReadFailed);
-        m_buffer.clear();
-        m_ws.async_read(m_buffer,
-                        beast::bind_front_handler(&Websocket::OnRead, shared_from_this()));
+        OnClosed();
         return;
     }
 
@@ -131,15 +193,25 @@ void Websocket::OnRead(beast::error_code ec, std::size_t) {
         return;
     }
 
-    std::size_t copied = 0;
-    auto const& seq = m_buffer.data();
-    for (auto it = boost::asio::buffer_sequence_begin(seq);
-         it != boost::asio::buffer_sequence_end(seq); ++it) {
-        std::memcpy(m_storage.data() + copied, it->data(), it->size());
-        copied += it->size();
+    // The frame is handed over in place, keep the padding promised by INotifier past its end
+    if (m_buffer.capacity() - m_buffer.size() < core::interface::receivePadding) [[unlikely]] {
+        m_buffer.reserve(m_buffer.size() + core::interface::receivePadding);
     }
 
-    m_notifier->OnReceiveSuccessed(std::span<std::byte>{m_storage.data(), copied});
+    const auto data = m_buffer.data();
+    const std::span<std::byte> frame{static_cast<std::byte*>(data.data()), data.size()};
+
+    if (m_recorder) [[unlikely]] {
+        m_recorder->Append(tsNs, frame);
+    }
+
+    m_notifier->OnReceiveSuccessed(frame, tsNs);
+    if (kernelTsNs != 0 && core::metrics::LatencyEnabled()) {
+        // the kernel and the process read the clock apart, a step back must not wrap
+        const auto nowNs = NowNs();
+        core::metrics::RecordLatency(core::metrics::Stage::Receive,
+                                     nowNs > kernelTsNs ? nowNs - kernelTsNs : 0);
+    }
     m_buffer.clear();
     m_ws.async_read(m_buffer, beast::bind_front_handler(&Websocket::OnRead, shared_from_this()));
 }
@@ -7,9 +7,16 @@
 #include <boost/beast/websocket.hpp>
 #include <boost/beast/websocket/ssl.hpp>
 #include <core/interface/notifier.hpp>
+#include <deque>
+#include <functional>
 #include <memory>
+#include <network/capture/recorder.hpp>
+#include <string>
 #include <string_view>
-#include <vector>
+
+#include "reconnect_policy.hpp"
+#include "timestamped_stream.hpp"
+#include "tls_context.hpp"
 
 namespace network::websockets {
 
@@ -24,17 +31,39 @@ using tcp = boost::asio::ip::tcp;
  * The Websocket class manages asynchronous connections to a WebSocket
  * server over TLS/SSL, reads messages, and dispatches events via
  * INotifier callbacks. It supports a maximum message size defined by `maxMsgSize`.
+ * Messages are read into a reusable flat buffer and handed to the notifier in place,
+ * followed by `core::interface::receivePadding` readable bytes. Outgoing text
+ * messages are queued and written one at a time on the strand of the stream.
+ * All connections share the TLS context of TlsContext and resume the cached TLS
+ * session of their host when there is one.
+ *
+ * Frames are stamped with the kernel receive time of the socket (SO_TIMESTAMPNS),
+ * falling back to the wall clock when the kernel provides none.
+ *
+ * A Websocket object serves a single connection attempt. Connect and handshakes are
+ * bounded by the connect timeout; once open, the stream pings the server and treats
+ * a connection silent for the idle timeout as dead. When the connection fails or
+ * is lost, the close handler is invoked once so that the owner can reconnect with a
+ * new object.
  */
 class Websocket final : public std::enable_shared_from_this<Websocket> {
 public:
     static constexpr uint16_t maxMsgSize = 10'000; /**< Maximum message size in bytes. */
 
+    /**
+     * @brief Callback invoked when the connection fails or is lost.
+     *
+     * @param wasOpen True if the WebSocket handshake had completed.
+     */
+    using CloseHandler = std::function<void(bool wasOpen)>;
+
     /**
      * @brief Constructs a WebSocket client instance.
      *
      * @param ioctx Reference to a Boost.Asio io_context for asynchronous operations.
+     * @param policy Connect and idle timeouts.
      */
-    explicit Websocket(boost::asio::io_context& ioctx);
+    Websocket(boost::asio::io_context& ioctx, const ReconnectPolicy& policy);
 
     /**
      * @brief Starts the WebSocket connection and handshake process.
@@ -54,6 +83,31 @@ public:
         m_notifier = notifier;
     }
 
+    /**
+     * @brief Enables recording of every received frame.
+     *
+     * @param recorder Recorder the frames are appended to, with their receive timestamps.
+     */
+    inline void SetRecorder(std::shared_ptr<capture::Recorder> recorder) noexcept {
+        m_recorder = std::move(recorder);
+    }
+
+    /**
+     * @brief Sets the handler invoked when the connection fails or is lost.
+     *
+     * It is not invoked for a stop requested via INotifier::OnStopRequested.
+     *
+     * @param handler Close handler.
+     */
+    inline void SetCloseHandler(CloseHandler handler) noexcept { m_onClose = std::move(handler); }
+
+    /**
+     * @brief Queues a text message for sending. Thread-safe.
+     *
+     * @param message The message to send.
+     */
+    void Send(std::string message);
+
     inline void Close() noexcept {
         beast::error_code ec;
         m_ws.close(boost::beast::websocket::close_code::normal, ec);
@@ -98,15 +152,36 @@ private:
      */
     void OnRead(beast::error_code ec, std::size_t bytes_transferred);
 
+    /**
+     * @brief Writes the first queued message.
+     */
+    void Write();
+
+    /**
+     * @brief Callback invoked when a message is written.
+     *
+     * @param ec Error code of the write operation.
+     * @param bytes_transferred Number of bytes written.
+     */
+    void OnWrite(beast::error_code ec, std::size_t bytes_transferred);
+
+    /**
+     * @brief Invokes the close handler, at most once.
+     */
+    void OnClosed();
+
 private:
+    ReconnectPolicy m_policy; /**< Connect and idle timeouts. */
     tcp::resolver m_resolver; /**< Resolver for DNS lookups. */
-    ssl::context m_ssl;       /**< SSL context for TLS connections. */
-    beast::websocket::stream<beast::ssl_stream<beast::tcp_stream>> m_ws; /**< WebSocket stream. */
-    std::vector<std::byte> m_storage;                /**< Temporary storage buffer. */
-    beast::flat_buffer m_buffer;                     /**< Flat buffer for incoming messages. */
-    std::string_view m_host;                         /**< WebSocket server hostname. */
-    std::string_view m_target;                       /**< WebSocket target path. */
+    beast::websocket::stream<beast::ssl_stream<TimestampedStream>> m_ws; /**< WebSocket stream. */
+    beast::flat_buffer m_buffer;                     /**< Padded buffer for incoming messages. */
+    std::string m_host;                              /**< WebSocket server hostname. */
+    std::string m_target;                            /**< WebSocket target path. */
     core::interface::INotifier* m_notifier{nullptr}; /**< Notifier for event callbacks. */
+    std::shared_ptr<capture::Recorder> m_recorder;   /**< Optional recorder of received frames. */
+    std::deque<std::string> m_writes;                /**< Messages waiting to be written. */
+    bool m_open = false;                             /**< Handshake done, writes may start. */
+    CloseHandler m_onClose;                          /**< Invoked when the connection is lost. */
 };
 
 }  // namespace network::websockets
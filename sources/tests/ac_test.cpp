@@ -0,0 +1,87 @@
+#include <algorithm>
+#include <cmath>
+#include <core/algorithm/ac.hpp>
+#include <exchange/binance/info.hpp>
+#include <exchange/binance/serializer.hpp>
+#include <vector>
+
+#include "bench/fixtures.hpp"
+#include "check.hpp"
+
+namespace {
+namespace ca = core::algorithm;
+
+/**
+ * @brief Trades of the fixture tracked against the depth snapshots, a book every 4 trades.
+ */
+ca::AlmgrenChrissTracker Track(ca::ACMode mode,
+                               const std::vector<common::event::NormalizedEvent>& trades,
+                               const std::vector<ca::OrderBook>& books) {
+    ca::AlmgrenChrissTracker tracker{exchange::binance::ethusdt, ca::ACConfig{.mode = mode}};
+    for (std::size_t i = 0; i < trades.size(); ++i) {
+        if (i % 4 == 0) {
+            tracker.UpdateBook(books[(i / 4) % books.size()]);
+        }
+        tracker.AddEvent(trades[i]);
+    }
+    return tracker;
+}
+
+bool Near(double lhs, double rhs) noexcept {
+    return std::abs(lhs - rhs) <= 1e-6 * std::max({1.0, std::abs(lhs), std::abs(rhs)});
+}
+
+/**
+ * @brief The online sums give the batch regression on the trade fixture.
+ */
+void OnlineMatchesBatch() {
+    exchange::binance::TradeSerializer serializer{exchange::binance::ethusdt};
+    const auto trades = bench::Parse(serializer, bench::LoadFixture("ethusdt_trade.jsonl"));
+    const auto books = bench::LoadBooks("ethusdt_depth20.jsonl");
+
+    auto batch = Track(ca::ACMode::Batch, trades, books);
+    auto online = Track(ca::ACMode::Online, trades, books);
+    CHECK(batch.Size() != 0);
+    CHECK(online.Size() == batch.Size());
+
+    const auto expected = batch.ComputeRegression();
+    const auto result = online.ComputeRegression();
+    CHECK(Near(result.gammaTemp, expected.gammaTemp));
+    CHECK(Near(result.phiPerm, expected.phiPerm));
+
+    online.ClearEvents();
+    CHECK(online.Size() == 0);
+    CHECK(online.ComputeRegression().gammaTemp == 0);
+}
+
+/**
+ * @brief A trade older than the head of a time-bounded window evicts nothing.
+ */
+void WindowKeepsOutOfOrderTrades() {
+    const ca::ACConfig config{.mode = ca::ACMode::Window,
+                              .windowSize = 16,
+                              .windowSpan = std::chrono::microseconds{1000}};
+    ca::AlmgrenChrissTracker tracker{exchange::binance::ethusdt, config};
+    tracker.UpdateBook(bench::LoadBooks("ethusdt_depth20.jsonl").front());
+
+    common::event::NormalizedEvent trade{};
+    trade.source = common::event::Source::Trade;
+    trade.size = 1;
+    for (uint64_t tsUs : {10'000, 10'500, 9'000, 10'900}) {
+        trade.exchangeTsUs = tsUs;
+        tracker.AddEvent(trade);
+    }
+    CHECK(tracker.Size() == 4);
+
+    // the window evicts in arrival order up to the first trade within the span
+    trade.exchangeTsUs = 11'600;
+    tracker.AddEvent(trade);
+    CHECK(tracker.Size() == 2);
+}
+}  // namespace
+
+int main() {
+    OnlineMatchesBatch();
+    WindowKeepsOutOfOrderTrades();
+    return tests::Result();
+}
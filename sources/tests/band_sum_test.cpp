@@ -0,0 +1,113 @@
+#include <common/event/event_columns.hpp>
+#include <core/algorithm/band_sum.hpp>
+#include <cstddef>
+#include <random>
+
+#include "check.hpp"
+
+namespace {
+namespace ca = core::algorithm;
+using Side = ca::OrderBook::Side;
+
+/**
+ * @brief Straightforward band sum the kernels are checked against.
+ */
+ca::OrderBook::BandSum Reference(const common::event::EventColumns& columns, Side side,
+                                 int64_t limit) {
+    ca::OrderBook::BandSum sum{0, 0};
+    for (std::size_t i = 0; i < columns.Size(); ++i) {
+        const bool bid = columns.IsBid(i);
+        const auto price = columns.price[i];
+        if (side == Side::Bid ? bid && price >= limit : !bid && price <= limit) {
+            sum.notional += price * columns.size[i];
+            sum.volume += columns.size[i];
+        }
+    }
+    return sum;
+}
+
+/**
+ * @brief Random events of both sides in any order, prices around `mid`.
+ */
+common::event::EventColumns Columns(std::mt19937_64& rng, std::size_t count, int64_t mid) {
+    std::uniform_int_distribution<int64_t> price{mid - 1000, mid + 1000};
+    std::uniform_int_distribution<int64_t> size{0, 1'000'000};
+    std::bernoulli_distribution bid{0.5};
+
+    common::event::EventColumns columns;
+    for (std::size_t i = 0; i < count; ++i) {
+        common::event::NormalizedEvent event{};
+        event.price = price(rng);
+        event.size = size(rng);
+        event.level = static_cast<uint16_t>(i);
+        event.type = bid(rng) ? common::event::Type::Bid : common::event::Type::Ask;
+        columns.Append(event);
+    }
+    return columns;
+}
+
+/**
+ * @brief Checks every supported kernel on both sides against the reference.
+ */
+void CheckKernels(const common::event::EventColumns& columns, int64_t limit) {
+    for (auto side : {Side::Bid, Side::Ask}) {
+        const auto expected = Reference(columns, side, limit);
+        for (auto isa : {ca::Isa::Scalar, ca::Isa::Sse42, ca::Isa::Avx2}) {
+            if (!ca::Supported(isa)) {
+                continue;
+            }
+            const auto sum = ca::SumBand(columns, side, limit, isa);
+            CHECK(sum.notional == expected.notional);
+            CHECK(sum.volume == expected.volume);
+        }
+    }
+}
+
+/**
+ * @brief Kernels agree on lengths around the vector widths and the 64-event side
+ * words, with limits below, inside and above the prices.
+ */
+void KernelsMatchScalar() {
+    std::mt19937_64 rng{42};
+    constexpr int64_t mid = 3'000'000;
+    for (std::size_t count = 0; count <= 200; ++count) {
+        const auto columns = Columns(rng, count, mid);
+        for (auto limit : {mid - 2000, mid - 500, mid, mid + 1, mid + 500, mid + 2000}) {
+            CheckKernels(columns, limit);
+        }
+    }
+}
+
+/**
+ * @brief Kernels ignore the side bits of events dropped by Truncate().
+ */
+void KernelsMatchAfterTruncate() {
+    std::mt19937_64 rng{7};
+    constexpr int64_t mid = 3'000'000;
+    for (std::size_t count : {1, 3, 63, 64, 65, 127, 130, 257}) {
+        auto columns = Columns(rng, 300, mid);
+        columns.Truncate(count);
+        CHECK(columns.Size() == count);
+        CheckKernels(columns, mid);
+
+        // events appended after the cut must not inherit the bits of the dropped ones
+        common::event::NormalizedEvent ask{};
+        ask.price = mid;
+        ask.size = 1;
+        ask.type = common::event::Type::Ask;
+        for (int i = 0; i < 5; ++i) {
+            columns.Append(ask);
+        }
+        for (std::size_t i = count; i < columns.Size(); ++i) {
+            CHECK(!columns.IsBid(i));
+        }
+        CheckKernels(columns, mid);
+    }
+}
+}  // namespace
+
+int main() {
+    KernelsMatchScalar();
+    KernelsMatchAfterTruncate();
+    return tests::Result();
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <fmt/format.h>
+
+#include <cstdio>
+
+namespace tests {
+
+/**
+ * @brief Number of failed checks of the running test executable.
+ */
+inline int& Failures() noexcept {
+    static int failures = 0;
+    return failures;
+}
+
+/**
+ * @brief Records a failed check.
+ */
+inline void Fail(const char* file, int line, const char* expression) noexcept {
+    ++Failures();
+    fmt::print(stderr, "{}:{}: check failed: {}\n", file, line, expression);
+}
+
+/**
+ * @brief Exit code of the test executable, non-zero if any check failed.
+ */
+inline int Result() noexcept {
+    if (Failures() != 0) {
+        fmt::print(stderr, "{} check(s) failed\n", Failures());
+        return 1;
+    }
+    return 0;
+}
+
+}  // namespace tests
+
+/**
+ * @brief Checks a condition, the test goes on after a failure and exits non-zero.
+ */
+#define CHECK(condition)                                   \
+    do {                                                   \
+        if (!(condition)) {                                \
+            ::tests::Fail(__FILE__, __LINE__, #condition); \
+        }                                                  \
+    } while (false)
@@ -0,0 +1,167 @@
+#include <chrono>
+#include <core/metrics/clock.hpp>
+#include <deque>
+#include <engine/event_bus.hpp>
+#include <engine/pipeline.hpp>
+#include <exchange/binance/info.hpp>
+#include <memory>
+#include <vector>
+
+#include "check.hpp"
+
+namespace {
+using core::interface::EventBatch;
+
+/**
+ * @brief Source of empty batches that records the receive times of the popped ones.
+ */
+class Source final : public core::interface::IEventSource {
+public:
+    explicit Source(std::vector<uint64_t>& applied) : m_applied(applied) {}
+
+    inline void Push(uint64_t recvTsUs) { m_batches.emplace_back().recvTsUs = recvTsUs; }
+
+    inline const EventBatch* Front() noexcept override {
+        return m_batches.empty() ? nullptr : &m_batches.front();
+    }
+
+    inline void Pop() noexcept override {
+        m_applied.push_back(m_batches.front().recvTsUs);
+        m_batches.pop_front();
+    }
+
+private:
+    std::vector<uint64_t>& m_applied; /**< Receive times of the popped batches. */
+    std::deque<EventBatch> m_batches; /**< Pending batches. */
+};
+
+engine::StrategyConfig Strategy() {
+    engine::StrategyConfig config;
+    config.symbol = exchange::binance::ethusdt;
+    config.venue = exchange::binance::venue;
+    config.params = exchange::binance::params;
+    return config;
+}
+
+/**
+ * @brief A bus of one symbol fed by two sources.
+ */
+struct Bus {
+    explicit Bus(std::chrono::microseconds window)
+        : bus(engine::EventBus::Options{window}), depth(applied), trade(applied) {
+        const auto symbol = bus.AddSymbol(Strategy());
+        bus.AddSource(symbol, depth);
+        bus.AddSource(symbol, trade);
+    }
+
+    void Drain() {
+        while (bus.Process()) {
+        }
+    }
+
+    engine::EventBus bus;
+    std::vector<uint64_t> applied;
+    Source depth;
+    Source trade;
+};
+
+/**
+ * @brief Batches of all sources are applied oldest first.
+ */
+void MergesInReceiveOrder() {
+    Bus bus{std::chrono::microseconds{0}};
+    for (uint64_t ts : {1, 4, 5}) {
+        bus.depth.Push(ts);
+    }
+    for (uint64_t ts : {2, 3, 6}) {
+        bus.trade.Push(ts);
+    }
+
+    bus.Drain();
+    CHECK((bus.applied == std::vector<uint64_t>{1, 2, 3, 4, 5, 6}));
+    CHECK(bus.bus.Late() == 0);
+}
+
+/**
+ * @brief Without a window an idle source does not hold the other back, a batch
+ * older than an applied one is counted as late.
+ */
+void CountsLateBatches() {
+    Bus bus{std::chrono::microseconds{0}};
+    bus.depth.Push(10);
+    bus.Drain();
+    CHECK((bus.applied == std::vector<uint64_t>{10}));
+
+    bus.trade.Push(5);
+    bus.Drain();
+    CHECK((bus.applied == std::vector<uint64_t>{10, 5}));
+    CHECK(bus.bus.Late() == 1);
+}
+
+/**
+ * @brief With a window the oldest batch waits for an idle source, and is applied
+ * in order once the idle source delivers or on Flush().
+ */
+void WaitsWithinTheWindow() {
+    Bus bus{std::chrono::minutes{1}};
+    const auto nowUs = core::metrics::NowUs();
+    bus.depth.Push(nowUs);
+    bus.depth.Push(nowUs + 2);
+    bus.Drain();
+    CHECK(bus.applied.empty());
+
+    bus.trade.Push(nowUs + 1);
+    bus.Drain();
+    CHECK((bus.applied == std::vector<uint64_t>{nowUs, nowUs + 1}));
+
+    while (bus.bus.Flush()) {
+    }
+    CHECK((bus.applied == std::vector<uint64_t>{nowUs, nowUs + 1, nowUs + 2}));
+    CHECK(bus.bus.Late() == 0);
+}
+
+/**
+ * @brief A batch older than the window is applied although a source is idle.
+ */
+void AppliesBatchesPastTheWindow() {
+    Bus bus{std::chrono::microseconds{1000}};
+    const auto oldUs = core::metrics::NowUs() - 10'000;
+    bus.depth.Push(oldUs);
+    bus.Drain();
+    CHECK((bus.applied == std::vector<uint64_t>{oldUs}));
+}
+
+/**
+ * @brief Stopping the pipeline applies the batches the bus still holds.
+ */
+void StopDrainsHeldBatches() {
+    std::vector<uint64_t> applied;
+    Source depth{applied};
+    Source trade{applied};
+    const auto nowUs = core::metrics::NowUs();
+    depth.Push(nowUs);
+    depth.Push(nowUs + 1);
+
+    auto bus =
+        std::make_unique<engine::EventBus>(engine::EventBus::Options{std::chrono::minutes{1}});
+    const auto symbol = bus->AddSymbol(Strategy());
+    bus->AddSource(symbol, depth);
+    bus->AddSource(symbol, trade);
+
+    engine::Pipeline pipeline;
+    pipeline.AddHandler(std::move(bus));
+    pipeline.Init();
+    pipeline.Start();
+    pipeline.Stop();
+    CHECK((applied == std::vector<uint64_t>{nowUs, nowUs + 1}));
+}
+}  // namespace
+
+int main() {
+    MergesInReceiveOrder();
+    CountsLateBatches();
+    WaitsWithinTheWindow();
+    AppliesBatchesPastTheWindow();
+    StopDrainsHeldBatches();
+    return tests::Result();
+}
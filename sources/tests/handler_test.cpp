@@ -0,0 +1,120 @@
+#include <exchange/binance/handler.hpp>
+#include <exchange/binance/info.hpp>
+#include <exchange/binance/serializer.hpp>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bench/allocations.hpp"
+#include "bench/fixtures.hpp"
+#include "bench/loopback_connector.hpp"
+#include "check.hpp"
+
+namespace {
+using common::event::NormalizedEvent;
+using exchange::binance::EventType;
+
+/**
+ * @brief A stream of the handler with its frames and the events they parse into.
+ */
+struct Stream {
+    EventType type;                        /**< Kind of the frames. */
+    std::string target;                    /**< Subscription target. */
+    std::vector<bench::Frame> frames;      /**< One frame per fixture message. */
+    std::vector<NormalizedEvent> expected; /**< Events of the bare serializer. */
+};
+
+template <typename Serializer>
+Stream LoadStream(EventType type, std::string target, std::string_view fixture) {
+    const auto messages = bench::LoadFixture(fixture);
+    Serializer serializer{exchange::binance::ethusdt};
+    Stream stream{type, std::move(target), {}, bench::Parse(serializer, messages)};
+    for (const auto& message : messages) {
+        stream.frames.emplace_back(std::vector{message}, 1);
+    }
+    return stream;
+}
+
+bool Same(const NormalizedEvent& lhs, const NormalizedEvent& rhs) noexcept {
+    return lhs.exchangeTsUs == rhs.exchangeTsUs && lhs.price == rhs.price &&
+           lhs.size == rhs.size && lhs.level == rhs.level && lhs.symbol == rhs.symbol &&
+           lhs.venue == rhs.venue && lhs.type == rhs.type && lhs.source == rhs.source;
+}
+
+/**
+ * @brief Pushes every frame of the streams through the handler, one at a time, and
+ * checks the batches against the bare serializers.
+ *
+ * @return Heap allocations made by the pass.
+ */
+uint64_t Pass(exchange::binance::Handler& handler, bench::LoopbackConnector& connector,
+              std::vector<Stream>& streams, bool resync) {
+    const auto allocations = bench::Allocations();
+    for (std::size_t idx = 0; idx < streams.size(); ++idx) {
+        auto& stream = streams[idx];
+        std::size_t next = 0;
+        for (std::size_t i = 0; i < stream.frames.size(); ++i) {
+            const uint64_t recvTsNs = (i + 1) * 1000;
+            connector.Push(idx, stream.frames[i].Data(), recvTsNs);
+            CHECK(handler.Parse());
+
+            const auto* batch = handler.Front();
+            CHECK(batch != nullptr);
+            if (batch == nullptr) {
+                return 0;
+            }
+            CHECK(batch->stream == idx);
+            CHECK(batch->recvTsUs == recvTsNs / 1000);
+            CHECK(batch->resync == (resync && i == 0));
+            for (const auto& event : batch->events) {
+                CHECK(next < stream.expected.size() && Same(event, stream.expected[next]));
+                ++next;
+            }
+            handler.Pop();
+        }
+        CHECK(next == stream.expected.size());
+    }
+    return bench::Allocations() - allocations;
+}
+
+/**
+ * @brief BasicHandler::Parse() parses frames into the batch slots of its ring like
+ * the bare serializers, and allocates nothing once the slots have grown.
+ */
+void ParsesIntoRingSlots() {
+    std::vector<Stream> streams;
+    streams.push_back(LoadStream<exchange::binance::DepthSerializer>(
+        EventType::Depth, "/ws/ethusdt@depth20@100ms", "ethusdt_depth20.jsonl"));
+    streams.push_back(LoadStream<exchange::binance::TradeSerializer>(
+        EventType::Trade, "/ws/ethusdt@trade", "ethusdt_trade.jsonl"));
+
+    // the smallest rings, so that the second pass fills the slots the first one grew
+    exchange::binance::Config config;
+    config.symbol = exchange::binance::ethusdt;
+    config.frameQueueSize = 2;
+    config.eventQueueSize = 2;
+    auto connector = std::make_shared<bench::LoopbackConnector>();
+    exchange::binance::Handler handler{connector, config};
+    for (const auto& stream : streams) {
+        handler.AddTarget(stream.type, stream.target);
+    }
+    handler.Init();
+
+    Pass(handler, *connector, streams, false);
+    // the depth fixture repeats its update ids, a reconnect restarts the sequence
+    for (std::size_t idx = 0; idx < streams.size(); ++idx) {
+        connector->Reconnect(idx);
+    }
+    CHECK(Pass(handler, *connector, streams, true) == 0);
+
+    const auto stats = handler.GetStats();
+    CHECK(stats.errors == 0);
+    CHECK(stats.framesDropped == 0);
+}
+}  // namespace
+
+int main() {
+    ParsesIntoRingSlots();
+    return tests::Result();
+}
@@ -0,0 +1,141 @@
+#include <common/event/packed_event.hpp>
+#include <common/exchange/registry.hpp>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+#include "check.hpp"
+
+namespace {
+using common::event::NormalizedEvent;
+using common::event::PackedEvent;
+
+constexpr int64_t maxValue = (int64_t{1} << (PackedEvent::valueBits - 1)) - 1;
+constexpr int64_t minValue = -(int64_t{1} << (PackedEvent::valueBits - 1));
+constexpr uint64_t maxTime = (uint64_t{1} << PackedEvent::timeBits) - 1;
+
+bool Same(const NormalizedEvent& lhs, const NormalizedEvent& rhs) noexcept {
+    return lhs.exchangeTsUs == rhs.exchangeTsUs && lhs.recvTsUs == rhs.recvTsUs &&
+           lhs.tsUs == rhs.tsUs && lhs.price == rhs.price && lhs.size == rhs.size &&
+           lhs.level == rhs.level && lhs.symbol == rhs.symbol && lhs.venue == rhs.venue &&
+           lhs.type == rhs.type && lhs.source == rhs.source;
+}
+
+void CheckRoundTrip(const NormalizedEvent& event) {
+    CHECK(PackedEvent::Fits(event));
+    const PackedEvent packed{event};
+    CHECK(Same(packed.Unpack(event.recvTsUs, event.tsUs), event));
+}
+
+/**
+ * @brief The edges of every field survive packing.
+ */
+void RoundTripsEdges() {
+    using common::event::Source;
+    using common::event::Type;
+
+    for (auto value : {int64_t{0}, int64_t{-1}, int64_t{1}, minValue, maxValue}) {
+        for (auto type : {Type::Bid, Type::Ask}) {
+            for (auto source : {Source::Depth, Source::Trade}) {
+                NormalizedEvent event{};
+                event.exchangeTsUs = maxTime;
+                event.recvTsUs = std::numeric_limits<uint64_t>::max();
+                event.tsUs = 1;
+                event.price = value;
+                event.size = -value;
+                event.level = std::numeric_limits<uint16_t>::max();
+                event.symbol = std::numeric_limits<common::exchange::SymbolId>::max();
+                event.venue = std::numeric_limits<common::exchange::VenueId>::max();
+                event.type = type;
+                event.source = source;
+                // -minValue does not fit, keep the size in range
+                if (value == minValue) {
+                    event.size = maxValue;
+                }
+                CheckRoundTrip(event);
+
+                event.exchangeTsUs = 0;
+                event.level = 0;
+                event.symbol = 0;
+                event.venue = 0;
+                CheckRoundTrip(event);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Random events within the layout survive packing.
+ */
+void RoundTripsRandomEvents() {
+    std::mt19937_64 rng{1};
+    std::uniform_int_distribution<int64_t> value{minValue, maxValue};
+    std::uniform_int_distribution<uint64_t> time{0, maxTime};
+    std::uniform_int_distribution<uint32_t> bits{0, std::numeric_limits<uint16_t>::max()};
+    for (int i = 0; i < 100'000; ++i) {
+        NormalizedEvent event{};
+        event.exchangeTsUs = time(rng);
+        event.recvTsUs = rng();
+        event.tsUs = rng();
+        event.price = value(rng);
+        event.size = value(rng);
+        event.level = static_cast<uint16_t>(bits(rng));
+        event.symbol = static_cast<common::exchange::SymbolId>(bits(rng));
+        event.venue = static_cast<common::exchange::VenueId>(bits(rng));
+        event.type = bits(rng) % 2 == 0 ? common::event::Type::Bid : common::event::Type::Ask;
+        event.source = bits(rng) % 2 == 0 ? common::event::Source::Depth
+                                          : common::event::Source::Trade;
+        CheckRoundTrip(event);
+    }
+}
+
+/**
+ * @brief Events out of the layout are rejected in every build type.
+ */
+void RejectsEventsThatDoNotFit() {
+    const auto rejected = [](const NormalizedEvent& event) {
+        if (PackedEvent::Fits(event)) {
+            return false;
+        }
+        try {
+            PackedEvent{event};
+        } catch (const std::out_of_range&) {
+            return true;
+        }
+        return false;
+    };
+
+    NormalizedEvent event{};
+    event.price = maxValue + 1;
+    CHECK(rejected(event));
+    event.price = minValue - 1;
+    CHECK(rejected(event));
+    event.price = 0;
+    event.size = maxValue + 1;
+    CHECK(rejected(event));
+    event.size = 0;
+    event.exchangeTsUs = maxTime + 1;
+    CHECK(rejected(event));
+}
+
+/**
+ * @brief Names of registered ids are found, unknown ids have no name.
+ */
+void LooksUpNames() {
+    const auto venue = common::exchange::RegisterVenue("test");
+    const auto symbol = common::exchange::RegisterSymbol(venue, "btcusdt");
+    CHECK(common::exchange::RegisterSymbol(venue, "btcusdt") == symbol);
+    CHECK(common::exchange::VenueName(venue) == "test");
+    CHECK(common::exchange::SymbolName(symbol) == "btcusdt");
+    CHECK(common::exchange::SymbolName(symbol + 1).empty());
+}
+}  // namespace
+
+int main() {
+    RoundTripsEdges();
+    RoundTripsRandomEvents();
+    RejectsEventsThatDoNotFit();
+    LooksUpNames();
+    return tests::Result();
+}